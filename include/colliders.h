@@ -170,6 +170,7 @@ class sphere_collider_set
             debugger.debug_faces[1].reset(
                 debugger.debug_vertices, fr::vertex_3d(0, 1, 0), 0, 3,
                 2, 0, 7);
+            debugger.debug_model.update_bounding_sphere();
 
             // Add mesh as static object
             if (static_count >= fr::constants_3d::max_static_models)
@@ -1,12 +1,16 @@
 #ifndef ENEMY_MANAGER_H
 #define ENEMY_MANAGER_H
 
+#include "bn_span.h"
+
 #include "fr_models_3d.h"
 #include "fr_constants_3d.h"
 
 #include "controller.h"
 #include "base_enemy.h"
 #include "stage_section.h"
+#include "stage_event.h"
+#include "stage_event_cursor.h"
 #include "colliders.h"
 #include "player_ship.h"
 
@@ -18,6 +22,7 @@ struct enemy_slot {
   bool used = false;
   base_enemy *ptr = nullptr; // dynamically created via models
   const enemy_def *source = nullptr; // descriptor origin
+  int section_index = -1; // owning section, -1 for refless objects such as bullets
   // <-- I might need optional fields for more complex enemies
 };
 
@@ -33,8 +38,10 @@ public:
   int statics_render(const fr::model_3d_item **static_model_items,
     int static_count);
 
-  // Basic section enemy processing: given current camera Y and all sections, print enemies in active sections.
-  void process_section_enemies(stage_section_list_ptr sections, size_t sections_count, bn::fixed camera_y);
+  // Basic section enemy processing: consumes the stage events reached by the camera, spawning the enemies of
+  // entered sections and destroying the ones of passed sections.
+  void process_section_enemies(const bn::span<const stage_event> &events, stage_section_list_ptr sections,
+                               bn::fixed camera_y);
 
   //
   void create_bullet(fr::point_3d position, fr::point_3d target);
@@ -48,9 +55,12 @@ public:
   static constexpr int MAX_ENEMIES = fr::constants_3d::max_dynamic_models - 1;
 
 private:
-  void spawn_asteroid(const enemy_def &enemy);
-  void spawn_oyster(const enemy_def &enemy);
-  void spawn_scorpion(const enemy_def &enemy);
+  void spawn_section_enemies(const stage_section *section, int section_index);
+  void destroy_section_enemies(const stage_section *section, int section_index);
+
+  void spawn_asteroid(const enemy_def &enemy, int section_index);
+  void spawn_oyster(const enemy_def &enemy, int section_index);
+  void spawn_scorpion(const enemy_def &enemy, int section_index);
 
   void check_end_section_cleaned();
 
@@ -62,8 +72,7 @@ private:
   controller *_controller;
   player_ship* _player;
 
-  bn::fixed _last_section_start_y = bn::fixed(32767);
-  bn::fixed _last_section_end_y = bn::fixed(32767);
+  stage_event_cursor _event_cursor;
 
   bool is_end_section_current = false;
 };
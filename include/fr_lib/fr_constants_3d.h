@@ -37,6 +37,88 @@
 #define FR_LOG_POLYGONS_PER_SECOND false
 #endif
 
+// Logs average and peak valid faces, visible faces and emitted hlines per
+// second. Useful for comparing renderer changes on the same scene.
+#ifndef FR_LOG_RENDER_STATS
+#define FR_LOG_RENDER_STATS false
+#endif
+
+// Bits per radix sort pass when sorting visible faces by depth (4 to 12).
+// More bits means less passes, but also more buckets to clear and scan.
+#ifndef FR_DEPTH_SORT_BUCKET_BITS
+#define FR_DEPTH_SORT_BUCKET_BITS 8
+#endif
+
+// Visible faces are first sorted by repairing the previous frame order with an
+// insertion sort. If it needs more moves than this value times the visible
+// faces count, a full radix sort is done instead.
+#ifndef FR_DEPTH_SORT_MAX_MOVES_PER_FACE
+#define FR_DEPTH_SORT_MAX_MOVES_PER_FACE 2
+#endif
+
+// Maximum number of faces (sprites included) and vertices processed per
+// frame. Faces indexes are 8 bits wide up to 255 faces and 16 bits wide
+// above that. When a frame goes over budget, the farthest faces and the
+// models whose vertices don't fit are dropped instead of aborting.
+#ifndef FR_MAX_FACES
+#define FR_MAX_FACES 176
+#endif
+
+#ifndef FR_MAX_VERTICES
+#define FR_MAX_VERTICES 256
+#endif
+
+// IWRAM share of the models_3d render arena, in bytes. GBA IWRAM is 32 KB, and
+// besides the arena it holds the stack, the IWRAM code (bn_iwram.cpp files
+// and fr_project_vertices.s, 276 bytes) and the rest of the globals. The game
+// logs the static IWRAM usage at startup (see main.cpp). Raising
+// FR_MAX_FACES, FR_MAX_VERTICES or FR_DEPTH_SORT_BUCKET_BITS past this budget
+// fails to build instead of leaving less stack than expected.
+#ifndef FR_RENDER_ARENA_MAX_SIZE
+#define FR_RENDER_ARENA_MAX_SIZE 12288
+#endif
+
+// Keeps the screen intervals covered by already added hlines on each screen
+// line, so hlines fully hidden by nearer faces don't take an HDMA sprite.
+// Faces are added from nearest to farthest, so covered hlines are always
+// behind. FR_COVERAGE_MAX_INTERVALS is the number of disjoint intervals
+// stored per screen line; new ones are not tracked once it's reached.
+#ifndef FR_COVERAGE_BUFFER
+#define FR_COVERAGE_BUFFER false
+#endif
+
+#ifndef FR_COVERAGE_MAX_INTERVALS
+#define FR_COVERAGE_MAX_INTERVALS 8
+#endif
+
+// Lowers LOD distances, sprites count and far distance when the renderer goes
+// over FR_RENDER_GOVERNOR_BUDGET_PERCENT of a frame or drops a frame during
+// FR_RENDER_GOVERNOR_OVER_BUDGET_FRAMES consecutive frames. Quality is
+// restored after FR_RENDER_GOVERNOR_RESTORE_FRAMES frames with headroom.
+// Disabled by default, since it makes frames depend on timing.
+#ifndef FR_RENDER_GOVERNOR
+#define FR_RENDER_GOVERNOR false
+#endif
+
+#ifndef FR_RENDER_GOVERNOR_BUDGET_PERCENT
+#define FR_RENDER_GOVERNOR_BUDGET_PERCENT 75
+#endif
+
+#ifndef FR_RENDER_GOVERNOR_OVER_BUDGET_FRAMES
+#define FR_RENDER_GOVERNOR_OVER_BUDGET_FRAMES 3
+#endif
+
+#ifndef FR_RENDER_GOVERNOR_RESTORE_FRAMES
+#define FR_RENDER_GOVERNOR_RESTORE_FRAMES 30
+#endif
+
+// Projects the vertices of static and translation only models with the ARM
+// kernel in fr_project_vertices.s instead of the C++ loop. Both give the same
+// output; the C++ loop is kept as reference.
+#ifndef FR_ARM_PROJECTION
+#define FR_ARM_PROJECTION true
+#endif
+
 // == GAME VARS
 
 // Enable profiler display by pressing SELECT
@@ -85,6 +167,7 @@ constexpr int max_dynamic_models = 20;
 constexpr int max_static_models = 64 - max_dynamic_models; // Original: 32
 constexpr int max_stage_models = 1024;
 constexpr int max_sprites = 8;
+constexpr int max_hdma_sprites = 32; // Per screen line, at the end of OAM
 
 // <-- What are these?
 constexpr int camera_min_y = 224;
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2020-2024 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef FR_DEPTH_SORT_H
+#define FR_DEPTH_SORT_H
+
+#include "bn_memory.h"
+#include "bn_utility.h"
+
+#include "fr_constants_3d.h"
+
+// Back to front sort of the visible faces, used by models_3d:
+namespace fr::depth_sort
+{
+
+// Depth keys are 16 bits wide; projected z has 8 fractional bits and the
+// division LUT limits it to 1024, so 2 of them are dropped:
+constexpr int key_bits = 16;
+constexpr int key_shift = 2;
+constexpr int key_max = (1 << key_bits) - 1;
+constexpr int bucket_bits = FR_DEPTH_SORT_BUCKET_BITS;
+constexpr int buckets = 1 << bucket_bits;
+constexpr int passes = (key_bits + bucket_bits - 1) / bucket_bits;
+
+static_assert(bucket_bits >= 4 && bucket_bits <= 12,
+              "Invalid depth sort bucket bits");
+
+// Farthest faces get the lowest keys, so sorting keys in ascending order
+// gives the same back to front order bn::sort gave before:
+[[nodiscard]] inline uint16_t key(int projected_z)
+{
+    int result = projected_z >> key_shift;
+
+    if (result < 0) [[unlikely]]
+    {
+        result = 0;
+    }
+    else if (result > key_max) [[unlikely]]
+    {
+        result = key_max;
+    }
+
+    return uint16_t(key_max - result);
+}
+
+// Adapts the previous frame order of old_count indexes to new_count indexes:
+// indexes which are still valid keep their relative order, and new ones are
+// appended at the end.
+template <typename Index>
+void resize_order(Index *indexes, int old_count, int new_count)
+{
+    int count = 0;
+
+    if (new_count < old_count)
+    {
+        for (int index = 0; index < old_count; ++index)
+        {
+            Index face_index = indexes[index];
+
+            if (face_index < new_count)
+            {
+                indexes[count] = face_index;
+                ++count;
+            }
+        }
+    }
+    else
+    {
+        count = old_count;
+    }
+
+    for (; count < new_count; ++count)
+    {
+        indexes[count] = Index(count);
+    }
+}
+
+// Insertion sort of the given indexes by their keys, which are not moved.
+// Returns false without finishing the sort if it needs more than max_moves,
+// leaving indexes as a permutation of the input ones.
+template <typename Index>
+[[nodiscard]] bool insertion_sort(const uint16_t *keys, Index *indexes,
+                                  int count, int max_moves)
+{
+    for (int sorted_count = 1; sorted_count < count; ++sorted_count)
+    {
+        Index index = indexes[sorted_count];
+        uint16_t key = keys[index];
+        int target_index = sorted_count;
+
+        while (target_index > 0 && keys[indexes[target_index - 1]] > key)
+        {
+            if (--max_moves < 0) [[unlikely]]
+            {
+                indexes[target_index] = index;
+                return false;
+            }
+
+            indexes[target_index] = indexes[target_index - 1];
+            --target_index;
+        }
+
+        indexes[target_index] = index;
+    }
+
+    return true;
+}
+
+// LSD radix sort of the given indexes by their keys. Keys and indexes are
+// sorted in place; temp_keys and temp_indexes must be as big as them, and
+// bucket_offsets must have room for buckets elements. Scratch buffers are
+// passed in (models_3d keeps them in its IWRAM arena) instead of being on the
+// stack, which is small and can be in slower memory.
+template <typename Index>
+void radix_sort(uint16_t *keys, Index *indexes, uint16_t *temp_keys,
+                Index *temp_indexes, uint16_t *bucket_offsets, int count)
+{
+    uint16_t *source_keys = keys;
+    Index *source_indexes = indexes;
+    uint16_t *target_keys = temp_keys;
+    Index *target_indexes = temp_indexes;
+
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        int shift = pass * bucket_bits;
+        bn::memory::clear(buckets, *bucket_offsets);
+
+        for (int index = 0; index < count; ++index)
+        {
+            ++bucket_offsets[(source_keys[index] >> shift) & (buckets - 1)];
+        }
+
+        // Skip passes which would leave everything in the same place:
+        if (bucket_offsets[(source_keys[0] >> shift) & (buckets - 1)] == count)
+        {
+            continue;
+        }
+
+        int offset = 0;
+
+        for (int bucket = 0; bucket < buckets; ++bucket)
+        {
+            int bucket_count = bucket_offsets[bucket];
+            bucket_offsets[bucket] = uint16_t(offset);
+            offset += bucket_count;
+        }
+
+        for (int index = 0; index < count; ++index)
+        {
+            uint16_t key = source_keys[index];
+            int target_index = bucket_offsets[(key >> shift) & (buckets - 1)]++;
+            target_keys[target_index] = key;
+            target_indexes[target_index] = source_indexes[index];
+        }
+
+        bn::swap(source_keys, target_keys);
+        bn::swap(source_indexes, target_indexes);
+    }
+
+    if (source_indexes != indexes)
+    {
+        bn::memory::copy(*source_keys, count, *keys);
+        bn::memory::copy(*source_indexes, count, *indexes);
+    }
+}
+
+} // namespace fr::depth_sort
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2020-2024 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef FR_FACE_CLUSTER_VISIBILITY_H
+#define FR_FACE_CLUSTER_VISIBILITY_H
+
+#include "bn_math.h"
+
+#include "fr_model_3d_item.h"
+
+// Back-face culling of whole face clusters, used by models_3d:
+namespace fr
+{
+
+enum class cluster_visibility
+{
+    hidden,
+    visible,
+    partial
+};
+
+// Tells if all faces of the given cluster (moved by center_offset) are seen
+// from the camera, none of them or only some. Distances are reduced to 4
+// fractional bits, with a quarter unit of slack to cover the rounding:
+[[nodiscard]] inline cluster_visibility face_cluster_visibility(
+    const face_cluster_3d &cluster, const point_3d &center_offset,
+    const point_3d &camera_position)
+{
+    int64_t cone_cos = cluster.cone_cos().data();
+
+    if (cone_cos < 0)
+    {
+        return cluster_visibility::partial;
+    }
+
+    constexpr int slack = 4;
+    point_3d distance = cluster.center() + center_offset - camera_position;
+    const point_3d &axis = cluster.axis();
+    int64_t x = distance.x().data() >> 8;
+    int64_t y = distance.y().data() >> 8;
+    int64_t z = distance.z().data() >> 8;
+    int64_t axis_distance =
+        ((x * axis.x().data()) + (y * axis.y().data()) +
+         (z * axis.z().data())) >> 12;
+
+    // Perpendicular distance is computed per component instead of with
+    // |distance|^2 - axis_distance^2, which cancels out near the axis. Each
+    // component is rounded away from zero to cover the truncated axis:
+    int64_t perpendicular_x =
+        bn::abs(x - ((axis_distance * axis.x().data()) >> 12)) + slack;
+    int64_t perpendicular_y =
+        bn::abs(y - ((axis_distance * axis.y().data()) >> 12)) + slack;
+    int64_t perpendicular_z =
+        bn::abs(z - ((axis_distance * axis.z().data()) >> 12)) + slack;
+    int64_t squared_perpendicular_distance =
+        (perpendicular_x * perpendicular_x) +
+        (perpendicular_y * perpendicular_y) +
+        (perpendicular_z * perpendicular_z);
+
+    int64_t cone_sin = cluster.cone_sin().data();
+    int64_t squared_limit =
+        (squared_perpendicular_distance * cone_sin * cone_sin) >> 24;
+    int64_t cos_distance = (cone_cos * axis_distance) >> 12;
+
+    if (axis_distance >= 0)
+    {
+        int64_t margin =
+            cos_distance + (cluster.min_offset().data() >> 8) - slack;
+
+        if (margin >= 0 && margin * margin >= squared_limit)
+        {
+            return cluster_visibility::hidden;
+        }
+    }
+    else
+    {
+        int64_t margin =
+            -(cos_distance + ((cluster.max_offset().data() + 255) >> 8)) -
+            slack;
+
+        if (margin > 0 && margin * margin > squared_limit)
+        {
+            return cluster_visibility::visible;
+        }
+    }
+
+    return cluster_visibility::partial;
+}
+
+} // namespace fr
+
+#endif
@@ -46,7 +46,11 @@ class model_3d : public bn::intrusive_list_node_type
     {
         BN_ASSERT(scale > 0, "Invalid scale: ", scale);
 
-        _scale = scale;
+        if (scale != _scale)
+        {
+            _scale = scale;
+            _transformed_faces_offset = -1;
+        }
     }
 
     [[nodiscard]] constexpr bn::fixed phi() const
@@ -169,7 +173,15 @@ class model_3d : public bn::intrusive_list_node_type
         return point_3d(rx, ry, rz);
     }
 
-    [[nodiscard]] constexpr point_3d transform(const vertex_3d &vertex) const
+    // Returns true if transform() only adds the position (no rotation and
+    // unit scale). Only valid after calling update().
+    [[nodiscard]] constexpr bool translation_only() const
+    {
+        return _identity_rotation && _scale == 1;
+    }
+
+    [[nodiscard]] constexpr point_3d rotate_and_scale(
+        const vertex_3d &vertex) const
     {
         point_3d result = rotate(vertex);
         bn::fixed scale = _scale;
@@ -181,7 +193,24 @@ class model_3d : public bn::intrusive_list_node_type
             result.set_z(result.z().unsafe_multiplication(scale));
         }
 
-        return result + _position;
+        return result;
+    }
+
+    [[nodiscard]] constexpr point_3d transform(const vertex_3d &vertex) const
+    {
+        return rotate_and_scale(vertex) + _position;
+    }
+
+    // Offset of this model faces in the models_3d transformed faces cache,
+    // or -1 if the cached faces are outdated:
+    [[nodiscard]] constexpr int transformed_faces_offset() const
+    {
+        return _transformed_faces_offset;
+    }
+
+    constexpr void set_transformed_faces_offset(int transformed_faces_offset)
+    {
+        _transformed_faces_offset = transformed_faces_offset;
     }
 
     constexpr void update()
@@ -198,6 +227,7 @@ class model_3d : public bn::intrusive_list_node_type
         bn::fixed psi_sin = _psi_sin;
         bn::fixed psi_cos = _psi_cos;
         _update = false;
+        _transformed_faces_offset = -1;
 
         bn::fixed phi_cos_theta_sin = phi_cos.unsafe_multiplication(theta_sin);
         _xx = phi_cos.unsafe_multiplication(theta_cos);
@@ -220,6 +250,9 @@ class model_3d : public bn::intrusive_list_node_type
         _xx_xy = _xx.unsafe_multiplication(_xy);
         _yx_yy = _yx.unsafe_multiplication(_yy);
         _zx_zy = _zx.unsafe_multiplication(_zy);
+
+        _identity_rotation = phi_sin == 0 && theta_sin == 0 && psi_sin == 0 &&
+                             phi_cos == 1 && theta_cos == 1 && psi_cos == 1;
     }
 
   private:
@@ -248,7 +281,9 @@ class model_3d : public bn::intrusive_list_node_type
     bn::fixed _xx_xy;
     bn::fixed _yx_yy;
     bn::fixed _zx_zy;
+    int _transformed_faces_offset = -1;
     bool _update = true;
+    bool _identity_rotation = false;
 };
 
 } // namespace fr
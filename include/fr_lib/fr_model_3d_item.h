@@ -15,6 +15,16 @@
 namespace fr
 {
 
+// Vertex indexes of a face. Triangles repeat the first vertex index as the
+// fourth one.
+struct face_indexes_3d
+{
+    int16_t first;
+    int16_t second;
+    int16_t third;
+    int16_t fourth;
+};
+
 class face_3d
 {
 
@@ -29,10 +39,10 @@ class face_3d
         : _centroid(_calculate_centroid(vertices, first_vertex_index,
                                         second_vertex_index,
                                         third_vertex_index)),
-          _normal(normal), _first_vertex_index(first_vertex_index),
-          _second_vertex_index(second_vertex_index),
-          _third_vertex_index(third_vertex_index),
-          _fourth_vertex_index(first_vertex_index), _color_index(color_index),
+          _normal(normal),
+          _indexes{int16_t(first_vertex_index), int16_t(second_vertex_index),
+                   int16_t(third_vertex_index), int16_t(first_vertex_index)},
+          _color_index(color_index),
           _shading(_calculate_shading(shading, normal.point().y())),
           _triangle(true)
     {
@@ -47,10 +57,10 @@ class face_3d
         : _centroid(_calculate_centroid(vertices, first_vertex_index,
                                         second_vertex_index, third_vertex_index,
                                         fourth_vertex_index)),
-          _normal(normal), _first_vertex_index(first_vertex_index),
-          _second_vertex_index(second_vertex_index),
-          _third_vertex_index(third_vertex_index),
-          _fourth_vertex_index(fourth_vertex_index), _color_index(color_index),
+          _normal(normal),
+          _indexes{int16_t(first_vertex_index), int16_t(second_vertex_index),
+                   int16_t(third_vertex_index), int16_t(fourth_vertex_index)},
+          _color_index(color_index),
           _shading(_calculate_shading(shading, normal.point().y())),
           _triangle(false)
     {
@@ -67,9 +77,9 @@ class face_3d
             _calculate_centroid(vertices, first_vertex_index,
                                 second_vertex_index, third_vertex_index);
         _normal = normal;
-        _first_vertex_index = first_vertex_index;
-        _second_vertex_index = second_vertex_index;
-        _third_vertex_index = third_vertex_index;
+        _indexes.first = int16_t(first_vertex_index);
+        _indexes.second = int16_t(second_vertex_index);
+        _indexes.third = int16_t(third_vertex_index);
         _color_index = color_index;
         _shading = _calculate_shading(shading, normal.point().y());
         _triangle = false;
@@ -84,10 +94,10 @@ class face_3d
                                         second_vertex_index, third_vertex_index,
                                         fourth_vertex_index);
         _normal = normal;
-        _first_vertex_index = first_vertex_index;
-        _second_vertex_index = second_vertex_index;
-        _third_vertex_index = third_vertex_index;
-        _fourth_vertex_index = fourth_vertex_index;
+        _indexes.first = int16_t(first_vertex_index);
+        _indexes.second = int16_t(second_vertex_index);
+        _indexes.third = int16_t(third_vertex_index);
+        _indexes.fourth = int16_t(fourth_vertex_index);
         _color_index = color_index;
         _shading = _calculate_shading(shading, normal.point().y());
         _triangle = false;
@@ -103,24 +113,29 @@ class face_3d
         return _normal;
     }
 
+    [[nodiscard]] constexpr const face_indexes_3d &indexes() const
+    {
+        return _indexes;
+    }
+
     [[nodiscard]] constexpr int first_vertex_index() const
     {
-        return _first_vertex_index;
+        return _indexes.first;
     }
 
     [[nodiscard]] constexpr int second_vertex_index() const
     {
-        return _second_vertex_index;
+        return _indexes.second;
     }
 
     [[nodiscard]] constexpr int third_vertex_index() const
     {
-        return _third_vertex_index;
+        return _indexes.third;
     }
 
     [[nodiscard]] constexpr int fourth_vertex_index() const
     {
-        return _fourth_vertex_index;
+        return _indexes.fourth;
     }
 
     [[nodiscard]] constexpr int color_index() const
@@ -154,10 +169,7 @@ class face_3d
   private:
     vertex_3d _centroid;
     vertex_3d _normal;
-    int16_t _first_vertex_index;
-    int16_t _second_vertex_index;
-    int16_t _third_vertex_index;
-    int16_t _fourth_vertex_index;
+    face_indexes_3d _indexes;
     int8_t _color_index;
     int8_t _shading;
     bool _triangle;
@@ -254,6 +266,406 @@ class face_3d
     }
 };
 
+// Face normal with 8 fractional bits:
+class packed_normal_3d
+{
+
+  public:
+    constexpr packed_normal_3d() = default;
+
+    constexpr explicit packed_normal_3d(const point_3d &normal)
+        : _x(_pack(normal.x())), _y(_pack(normal.y())), _z(_pack(normal.z()))
+    {
+    }
+
+    [[nodiscard]] constexpr point_3d point() const
+    {
+        return point_3d(bn::fixed::from_data(_x << 4),
+                        bn::fixed::from_data(_y << 4),
+                        bn::fixed::from_data(_z << 4));
+    }
+
+  private:
+    int16_t _x = 0;
+    int16_t _y = 0;
+    int16_t _z = 0;
+
+    [[nodiscard]] constexpr static int16_t _pack(bn::fixed value)
+    {
+        return int16_t((value.data() + 8) >> 4);
+    }
+};
+
+// Color index, shading and triangle flag of a face in one byte:
+class face_material_3d
+{
+
+  public:
+    constexpr face_material_3d() = default;
+
+    constexpr explicit face_material_3d(const face_3d &face)
+        : _data(uint8_t(face.color_index() | (face.shading() << 4) |
+                        (int(face.triangle()) << 7)))
+    {
+    }
+
+    [[nodiscard]] constexpr int color_index() const
+    {
+        return _data & 0xF;
+    }
+
+    [[nodiscard]] constexpr int shading() const
+    {
+        return (_data >> 4) & 0x7;
+    }
+
+    [[nodiscard]] constexpr bool triangle() const
+    {
+        return _data >> 7;
+    }
+
+  private:
+    static_assert(face_3d::max_colors <= 16);
+
+    uint8_t _data = 0;
+};
+
+// Storage of a packed_faces_3d, built at compile time from the given faces.
+template <int FacesCount> class packed_faces_3d_array
+{
+    static_assert(FacesCount > 0);
+
+  public:
+    constexpr packed_faces_3d_array() = default;
+
+    constexpr explicit packed_faces_3d_array(
+        const bn::span<const face_3d> &faces)
+    {
+        BN_ASSERT(faces.size() == FacesCount,
+                  "Invalid faces count: ", faces.size(), " - ", FacesCount);
+
+        for (int index = 0; index < FacesCount; ++index)
+        {
+            const face_3d &face = faces[index];
+            _indexes[index] = face.indexes();
+            _centroids[index] = face.centroid().point();
+            _normals[index] = packed_normal_3d(face.normal().point());
+            _materials[index] = face_material_3d(face);
+        }
+    }
+
+    [[nodiscard]] constexpr const face_indexes_3d *indexes() const
+    {
+        return _indexes;
+    }
+
+    [[nodiscard]] constexpr const point_3d *centroids() const
+    {
+        return _centroids;
+    }
+
+    [[nodiscard]] constexpr const packed_normal_3d *normals() const
+    {
+        return _normals;
+    }
+
+    [[nodiscard]] constexpr const face_material_3d *materials() const
+    {
+        return _materials;
+    }
+
+  private:
+    face_indexes_3d _indexes[FacesCount] = {};
+    point_3d _centroids[FacesCount];
+    packed_normal_3d _normals[FacesCount];
+    face_material_3d _materials[FacesCount];
+};
+
+// Faces stored as separate arrays, so the renderer per-face loops don't read
+// the data they don't need. The centroid xy products aren't stored and the
+// normals are quantized to 8 fractional bits.
+class packed_faces_3d
+{
+
+  public:
+    constexpr packed_faces_3d() = default;
+
+    template <int FacesCount>
+    constexpr explicit packed_faces_3d(
+        const packed_faces_3d_array<FacesCount> &array)
+        : _indexes(array.indexes()), _centroids(array.centroids()),
+          _normals(array.normals()), _materials(array.materials()),
+          _size(FacesCount)
+    {
+    }
+
+    [[nodiscard]] constexpr const face_indexes_3d *indexes() const
+    {
+        return _indexes;
+    }
+
+    [[nodiscard]] constexpr const point_3d *centroids() const
+    {
+        return _centroids;
+    }
+
+    [[nodiscard]] constexpr const packed_normal_3d *normals() const
+    {
+        return _normals;
+    }
+
+    [[nodiscard]] constexpr const face_material_3d *materials() const
+    {
+        return _materials;
+    }
+
+    [[nodiscard]] constexpr int size() const
+    {
+        return _size;
+    }
+
+  private:
+    const face_indexes_3d *_indexes = nullptr;
+    const point_3d *_centroids = nullptr;
+    const packed_normal_3d *_normals = nullptr;
+    const face_material_3d *_materials = nullptr;
+    int _size = 0;
+};
+
+// Consecutive faces whose normals fit in a cone, so the renderer can accept
+// or reject all of them with one test. Faces are seen from the camera if
+// (centroid - camera) . normal < 0; for every face of the cluster:
+//   (centroid - camera) . normal = (centroid - center) . normal +
+//                                  (center - camera) . normal
+// The first term is between min_offset and max_offset, and the angle between
+// normal and axis is at most acos(cone_cos).
+// Bounds are built from the normals the per-face test multiplies by (see
+// _culling_normal), both unpacked and packed, so the cluster verdict matches
+// it with both faces layouts.
+class face_cluster_3d
+{
+
+  public:
+    constexpr face_cluster_3d() = default;
+
+    constexpr face_cluster_3d(const bn::span<const face_3d> &faces,
+                              int first_face_index, int faces_count)
+        : _first_face_index(int16_t(first_face_index)),
+          _faces_count(int16_t(faces_count))
+    {
+        BN_ASSERT(first_face_index >= 0 && faces_count > 0 &&
+                      first_face_index + faces_count <= faces.size(),
+                  "Invalid cluster faces: ", first_face_index, " - ",
+                  faces_count, " - ", faces.size());
+
+        const face_3d *cluster_faces = faces.data() + first_face_index;
+        point_3d minimum = cluster_faces[0].centroid().point();
+        point_3d maximum = minimum;
+        point_3d normals_sum;
+
+        for (int index = 0; index < faces_count; ++index)
+        {
+            const point_3d &centroid = cluster_faces[index].centroid().point();
+            minimum.set_x(bn::min(minimum.x(), centroid.x()));
+            minimum.set_y(bn::min(minimum.y(), centroid.y()));
+            minimum.set_z(bn::min(minimum.z(), centroid.z()));
+            maximum.set_x(bn::max(maximum.x(), centroid.x()));
+            maximum.set_y(bn::max(maximum.y(), centroid.y()));
+            maximum.set_z(bn::max(maximum.z(), centroid.z()));
+            normals_sum +=
+                _unit(_culling_normal(cluster_faces[index].normal().point()));
+        }
+
+        _center = point_3d((minimum.x() + maximum.x()) / 2,
+                           (minimum.y() + maximum.y()) / 2,
+                           (minimum.z() + maximum.z()) / 2);
+        _axis = _unit(normals_sum / faces_count);
+
+        // Bounds are rounded outwards:
+        constexpr bn::fixed epsilon = bn::fixed::from_data(1);
+        _cone_cos = 1;
+        _min_offset = 0;
+        _max_offset = 0;
+
+        for (int index = 0; index < faces_count; ++index)
+        {
+            const face_3d &face = cluster_faces[index];
+            const point_3d &face_normal = face.normal().point();
+            point_3d normals[] = {
+                _unit(_culling_normal(face_normal)),
+                _unit(_culling_normal(packed_normal_3d(face_normal).point()))};
+
+            for (const point_3d &normal : normals)
+            {
+                bn::fixed offset =
+                    _dot_product(face.centroid().point() - _center, normal);
+                _cone_cos = bn::min(_cone_cos, _dot_product(normal, _axis));
+                _min_offset = bn::min(_min_offset, offset - epsilon);
+                _max_offset = bn::max(_max_offset, offset + epsilon);
+            }
+        }
+
+        _cone_cos -= epsilon;
+
+        if (_cone_cos >= 0)
+        {
+            int cos_data = _cone_cos.data();
+            int sin_data = bn::sqrt((1 << 24) - (cos_data * cos_data));
+            _cone_sin = bn::fixed::from_data(sin_data) + epsilon;
+        }
+        else
+        {
+            // Normals too far apart, every face must be tested:
+            _cone_cos = -1;
+            _cone_sin = 1;
+        }
+    }
+
+    [[nodiscard]] constexpr int first_face_index() const
+    {
+        return _first_face_index;
+    }
+
+    [[nodiscard]] constexpr int faces_count() const
+    {
+        return _faces_count;
+    }
+
+    [[nodiscard]] constexpr const point_3d &center() const
+    {
+        return _center;
+    }
+
+    // Unit length average normal:
+    [[nodiscard]] constexpr const point_3d &axis() const
+    {
+        return _axis;
+    }
+
+    // Cosine of the cone angle, or -1 if it's wider than 90 degrees:
+    [[nodiscard]] constexpr bn::fixed cone_cos() const
+    {
+        return _cone_cos;
+    }
+
+    [[nodiscard]] constexpr bn::fixed cone_sin() const
+    {
+        return _cone_sin;
+    }
+
+    [[nodiscard]] constexpr bn::fixed min_offset() const
+    {
+        return _min_offset;
+    }
+
+    [[nodiscard]] constexpr bn::fixed max_offset() const
+    {
+        return _max_offset;
+    }
+
+  private:
+    point_3d _center;
+    point_3d _axis;
+    bn::fixed _cone_cos;
+    bn::fixed _cone_sin;
+    bn::fixed _min_offset;
+    bn::fixed _max_offset;
+    int16_t _first_face_index = 0;
+    int16_t _faces_count = 0;
+
+    // Full precision dot product (safe_dot_product drops too many bits for
+    // the cone bounds):
+    [[nodiscard]] constexpr static bn::fixed _dot_product(const point_3d &a,
+                                                          const point_3d &b)
+    {
+        int64_t result = (int64_t(a.x().data()) * b.x().data()) +
+                         (int64_t(a.y().data()) * b.y().data()) +
+                         (int64_t(a.z().data()) * b.z().data());
+        return bn::fixed::from_data(int(result >> bn::fixed::precision()));
+    }
+
+    // Faces are tested with bn::fixed::safe_multiplication, which drops the
+    // lowest half of the fractional bits of both operands:
+    [[nodiscard]] constexpr static point_3d _culling_normal(
+        const point_3d &normal)
+    {
+        constexpr int mask = ~((1 << (bn::fixed::precision() / 2)) - 1);
+        return point_3d(bn::fixed::from_data(normal.x().data() & mask),
+                        bn::fixed::from_data(normal.y().data() & mask),
+                        bn::fixed::from_data(normal.z().data() & mask));
+    }
+
+    [[nodiscard]] constexpr static point_3d _unit(const point_3d &vector)
+    {
+        int squared_length = _dot_product(vector, vector).data() << 12;
+
+        if (squared_length <= 0)
+        {
+            return point_3d();
+        }
+
+        bn::fixed length = bn::fixed::from_data(bn::sqrt(squared_length));
+        return point_3d(vector.x().safe_division(length),
+                        vector.y().safe_division(length),
+                        vector.z().safe_division(length));
+    }
+};
+
+// Storage of the face clusters of a model, built at compile time from its
+// faces and the faces count of each cluster. Clusters must cover all faces
+// in order.
+template <int ClustersCount> class face_clusters_3d_array
+{
+    static_assert(ClustersCount > 0);
+
+  public:
+    constexpr face_clusters_3d_array() = default;
+
+    constexpr face_clusters_3d_array(const bn::span<const face_3d> &faces,
+                                     const int (&faces_counts)[ClustersCount])
+    {
+        int first_face_index = 0;
+
+        for (int index = 0; index < ClustersCount; ++index)
+        {
+            _clusters[index] =
+                face_cluster_3d(faces, first_face_index, faces_counts[index]);
+            first_face_index += faces_counts[index];
+        }
+
+        BN_ASSERT(first_face_index == faces.size(),
+                  "Clusters don't cover all faces: ", first_face_index, " - ",
+                  faces.size());
+    }
+
+    // Same clusters of other faces with the same layout (rotated ones, for
+    // example):
+    constexpr face_clusters_3d_array(
+        const bn::span<const face_3d> &faces,
+        const bn::span<const face_cluster_3d> &clusters)
+    {
+        BN_ASSERT(clusters.size() == ClustersCount,
+                  "Invalid clusters count: ", clusters.size(), " - ",
+                  ClustersCount);
+
+        for (int index = 0; index < ClustersCount; ++index)
+        {
+            const face_cluster_3d &cluster = clusters[index];
+            _clusters[index] =
+                face_cluster_3d(faces, cluster.first_face_index(),
+                                cluster.faces_count());
+        }
+    }
+
+    [[nodiscard]] constexpr bn::span<const face_cluster_3d> clusters() const
+    {
+        return bn::span<const face_cluster_3d>(_clusters, ClustersCount);
+    }
+
+  private:
+    face_cluster_3d _clusters[ClustersCount];
+};
+
 class model_3d_vertical_cylinder
 {
 
@@ -291,6 +703,116 @@ class model_3d_vertical_cylinder
     int _integer_radius = 0;
 };
 
+class model_3d_bounding_sphere
+{
+
+  public:
+    constexpr model_3d_bounding_sphere() : _center(0, 0, 0)
+    {
+    }
+
+    constexpr model_3d_bounding_sphere(const point_3d &center,
+                                       int integer_radius)
+        : _center(center), _integer_radius(integer_radius)
+    {
+        BN_ASSERT(integer_radius >= 0,
+                  "Invalid integer radius: ", integer_radius);
+    }
+
+    [[nodiscard]] constexpr const vertex_3d &center() const
+    {
+        return _center;
+    }
+
+    [[nodiscard]] constexpr int integer_radius() const
+    {
+        return _integer_radius;
+    }
+
+  private:
+    vertex_3d _center;
+    int _integer_radius = 0;
+};
+
+// Part of a model_3d_item merged from other ones (see
+// merged_static_model_3d_item). Each part keeps its faces and clusters
+// ranges, its palette and its collision data, so a part with vertices behind
+// the near plane can be dropped without dropping the whole model.
+class model_3d_sub_range
+{
+
+  public:
+    constexpr model_3d_sub_range() = default;
+
+    constexpr model_3d_sub_range(
+        int first_face_index, int faces_count, int first_cluster_index,
+        int clusters_count, const bn::color *palette,
+        const face_3d *collision_face = nullptr,
+        const model_3d_vertical_cylinder *vertical_cylinder = nullptr)
+        : _palette(palette), _collision_face(collision_face),
+          _vertical_cylinder(vertical_cylinder),
+          _first_face_index(int16_t(first_face_index)),
+          _faces_count(int16_t(faces_count)),
+          _first_cluster_index(int16_t(first_cluster_index)),
+          _clusters_count(int16_t(clusters_count))
+    {
+        BN_ASSERT(first_face_index >= 0,
+                  "Invalid first face index: ", first_face_index);
+        BN_ASSERT(faces_count > 0, "Invalid faces count: ", faces_count);
+        BN_ASSERT(first_cluster_index >= 0,
+                  "Invalid first cluster index: ", first_cluster_index);
+        BN_ASSERT(clusters_count >= 0,
+                  "Invalid clusters count: ", clusters_count);
+    }
+
+    [[nodiscard]] constexpr int first_face_index() const
+    {
+        return _first_face_index;
+    }
+
+    [[nodiscard]] constexpr int faces_count() const
+    {
+        return _faces_count;
+    }
+
+    // Clusters covering the faces of this sub-range in order, if any:
+    [[nodiscard]] constexpr int first_cluster_index() const
+    {
+        return _first_cluster_index;
+    }
+
+    [[nodiscard]] constexpr int clusters_count() const
+    {
+        return _clusters_count;
+    }
+
+    [[nodiscard]] constexpr const bn::color *palette() const
+    {
+        return _palette;
+    }
+
+    // Collision data of the model this sub-range comes from, if any:
+    [[nodiscard]] constexpr const face_3d *collision_face() const
+    {
+        return _collision_face;
+    }
+
+    [[nodiscard]] constexpr const model_3d_vertical_cylinder *
+    vertical_cylinder() const
+    {
+        return _vertical_cylinder;
+    }
+
+  private:
+    const bn::color *_palette = nullptr;
+    const face_3d *_collision_face = nullptr;
+    const model_3d_vertical_cylinder *_vertical_cylinder = nullptr;
+    int16_t _first_face_index = 0;
+    int16_t _faces_count = 0;
+    int16_t _first_cluster_index = 0;
+    int16_t _clusters_count = 0;
+};
+
 class model_3d_item
 {
 
@@ -324,17 +846,66 @@ class model_3d_item
     {
     }
 
+    // lower_detail replaces this item when the model is at least
+    // lower_detail_distance units away from the camera.
+    constexpr model_3d_item(const bn::span<const vertex_3d> &vertices,
+                            const bn::span<const face_3d> &faces,
+                            const bn::color *palette,
+                            const model_3d_item &lower_detail,
+                            int lower_detail_distance)
+        : model_3d_item(vertices, faces, nullptr, nullptr, palette,
+                        &lower_detail, lower_detail_distance)
+    {
+    }
+
     constexpr model_3d_item(const bn::span<const vertex_3d> &vertices,
                             const bn::span<const face_3d> &faces,
                             const face_3d *collision_face,
                             const model_3d_vertical_cylinder *vertical_cylinder,
-                            const bn::color *palette)
-        : _vertices(vertices), _faces(faces), _collision_face(collision_face),
-          _vertical_cylinder(vertical_cylinder), _palette(palette)
+                            const bn::color *palette,
+                            const model_3d_item *lower_detail = nullptr,
+                            int lower_detail_distance = 0,
+                            const packed_faces_3d *packed_faces = nullptr,
+                            const bn::span<const face_cluster_3d>
+                                &face_clusters = {},
+                            const bn::span<const model_3d_sub_range>
+                                &sub_ranges = {})
+        : _vertices(vertices), _faces(faces), _face_clusters(face_clusters),
+          _sub_ranges(sub_ranges),
+          _collision_face(collision_face),
+          _vertical_cylinder(vertical_cylinder), _palette(palette),
+          _lower_detail(lower_detail), _packed_faces(packed_faces),
+          _lower_detail_distance(lower_detail_distance),
+          _bounding_sphere(_calculate_bounding_sphere(vertices))
     {
         BN_ASSERT(vertices.size() > 0 && vertices.size() < 32768,
                   "Invalid vertices count: ", vertices.size());
         BN_ASSERT(!faces.empty(), "There's no faces");
+        BN_ASSERT(!packed_faces || packed_faces->size() == faces.size(),
+                  "Invalid packed faces count: ", packed_faces->size(), " - ",
+                  faces.size());
+        BN_ASSERT(face_clusters.empty() || !sub_ranges.empty() ||
+                      face_clusters.back().first_face_index() +
+                              face_clusters.back().faces_count() ==
+                          faces.size(),
+                  "Clusters don't cover all faces");
+        BN_ASSERT(sub_ranges.empty() ||
+                      sub_ranges.back().first_face_index() +
+                              sub_ranges.back().faces_count() ==
+                          faces.size(),
+                  "Sub-ranges don't cover all faces");
+
+        if (lower_detail)
+        {
+            BN_ASSERT(lower_detail_distance > 0,
+                      "Invalid lower detail distance: ", lower_detail_distance);
+            BN_ASSERT(lower_detail->vertices().size() <= vertices.size(),
+                      "Lower detail has more vertices: ",
+                      lower_detail->vertices().size(), " - ", vertices.size());
+            BN_ASSERT(lower_detail->faces().size() <= faces.size(),
+                      "Lower detail has more faces: ",
+                      lower_detail->faces().size(), " - ", faces.size());
+        }
     }
 
     [[nodiscard]] constexpr const bn::span<const vertex_3d> &vertices() const
@@ -363,12 +934,106 @@ class model_3d_item
         return _palette;
     }
 
+    [[nodiscard]] constexpr const model_3d_item *lower_detail() const
+    {
+        return _lower_detail;
+    }
+
+    [[nodiscard]] constexpr int lower_detail_distance() const
+    {
+        return _lower_detail_distance;
+    }
+
+    // Clusters covering all faces in order, or empty. If there's sub-ranges,
+    // each one references its own clusters instead:
+    [[nodiscard]] constexpr const bn::span<const face_cluster_3d> &
+    face_clusters() const
+    {
+        return _face_clusters;
+    }
+
+    // Sub-ranges covering all faces in order if this item was merged from
+    // other ones, or empty:
+    [[nodiscard]] constexpr const bn::span<const model_3d_sub_range> &
+    sub_ranges() const
+    {
+        return _sub_ranges;
+    }
+
+    // Same faces as faces(), read by the renderer instead of them if present:
+    [[nodiscard]] constexpr const packed_faces_3d *packed_faces() const
+    {
+        return _packed_faces;
+    }
+
+    [[nodiscard]] constexpr const model_3d_bounding_sphere &bounding_sphere()
+        const
+    {
+        return _bounding_sphere;
+    }
+
+    // Must be called after modifying the vertices referenced by this item,
+    // otherwise it can be culled while being on screen.
+    constexpr void update_bounding_sphere()
+    {
+        _bounding_sphere = _calculate_bounding_sphere(_vertices);
+    }
+
   private:
     bn::span<const vertex_3d> _vertices;
     bn::span<const face_3d> _faces;
+    bn::span<const face_cluster_3d> _face_clusters;
+    bn::span<const model_3d_sub_range> _sub_ranges;
     const face_3d *_collision_face;
     const model_3d_vertical_cylinder *_vertical_cylinder;
     const bn::color *_palette;
+    const model_3d_item *_lower_detail;
+    const packed_faces_3d *_packed_faces;
+    int _lower_detail_distance;
+    model_3d_bounding_sphere _bounding_sphere;
+
+    [[nodiscard]] constexpr static model_3d_bounding_sphere
+    _calculate_bounding_sphere(const bn::span<const vertex_3d> &vertices)
+    {
+        if (vertices.empty())
+        {
+            return model_3d_bounding_sphere();
+        }
+
+        point_3d minimum = vertices[0].point();
+        point_3d maximum = minimum;
+
+        for (const vertex_3d &vertex : vertices)
+        {
+            const point_3d &point = vertex.point();
+            minimum.set_x(bn::min(minimum.x(), point.x()));
+            minimum.set_y(bn::min(minimum.y(), point.y()));
+            minimum.set_z(bn::min(minimum.z(), point.z()));
+            maximum.set_x(bn::max(maximum.x(), point.x()));
+            maximum.set_y(bn::max(maximum.y(), point.y()));
+            maximum.set_z(bn::max(maximum.z(), point.z()));
+        }
+
+        point_3d center((minimum.x() + maximum.x()) / 2,
+                        (minimum.y() + maximum.y()) / 2,
+                        (minimum.z() + maximum.z()) / 2);
+        int max_squared_radius = 0;
+
+        for (const vertex_3d &vertex : vertices)
+        {
+            point_3d distance = vertex.point() - center;
+            int abs_x = bn::abs(distance.x()).ceil_integer();
+            int abs_y = bn::abs(distance.y()).ceil_integer();
+            int abs_z = bn::abs(distance.z()).ceil_integer();
+            int squared_radius =
+                (abs_x * abs_x) + (abs_y * abs_y) + (abs_z * abs_z);
+            max_squared_radius = bn::max(max_squared_radius, squared_radius);
+        }
+
+        // +1 to compensate sqrt truncation:
+        return model_3d_bounding_sphere(center,
+                                        bn::sqrt(max_squared_radius) + 1);
+    }
 };
 
 class face_texture
@@ -11,11 +11,15 @@
 #include "bn_intrusive_list.h"
 #include "bn_pool.h"
 #include "bn_span.h"
+#include "bn_type_traits.h"
 
 #include "fr_constants_3d.h"
+#include "fr_depth_sort.h"
 #include "fr_model_3d.h"
+#include "fr_render_governor.h"
 #include "fr_shape_groups.h"
 #include "fr_sprite_3d.h"
+#include "fr_vertex_projection.h"
 
 namespace fr
 {
@@ -26,6 +30,15 @@ class models_3d
 {
 
   public:
+    // max_hdma_sprites is the number of faces and sprites which can be drawn
+    // on each screen line. See shape_groups.
+    explicit models_3d(
+        int max_hdma_sprites = constants_3d::max_hdma_sprites) :
+        _shape_groups(max_hdma_sprites)
+    {
+        _fill_render_arena();
+    }
+
     void load_colors(const bn::span<const bn::color> &colors)
     {
         _shape_groups.load_colors(colors);
@@ -68,6 +81,17 @@ class models_3d
     void set_static_model_items(const model_3d_item **static_model_items_ptr,
                                 int static_models_count);
 
+    // Static models can be split in a retained segment, whose counts are
+    // only recalculated when it's set (stage models, for example), followed
+    // by a transient one which can change every frame. Setting the retained
+    // segment clears the transient one:
+    void set_retained_static_model_items(
+        const model_3d_item **static_model_items_ptr,
+        int retained_models_count);
+
+    // Transient static models must be stored right after the retained ones:
+    void set_transient_static_models_count(int transient_models_count);
+
     [[nodiscard]] model_3d &create_dynamic_model(
         const model_3d_item &model_item);
     [[nodiscard]] model_3d &create_dynamic_model(
@@ -81,6 +105,15 @@ class models_3d
 
     void update(const camera_3d &camera);
 
+    // Call instead of update() on frozen frames (pause, hit-stop, menus).
+    // The last frame stays on screen without projecting nor rasterizing
+    // anything, and fades set with set_fade still apply to it:
+    void retain_last_frame()
+    {
+        _shape_groups.retain_last_frame();
+        _render_governor.skip_frame();
+    }
+
     int dynamic_models_count() const
     {
         return _dynamic_models_list.size();
@@ -106,19 +139,87 @@ class models_3d
         return _sprites_pool.full();
     }
 
+    // Render stats of the last update() call:
+
+    int valid_faces_count() const
+    {
+        return _valid_faces_count;
+    }
+
+    int visible_faces_count() const
+    {
+        return _visible_faces_count;
+    }
+
+    int hlines_count() const
+    {
+        return _shape_groups.hlines_count();
+    }
+
+    // Faces (sprites included) which didn't fit in the faces and vertices
+    // budgets:
+    int dropped_faces_count() const
+    {
+        return _dropped_faces_count;
+    }
+
+    // Size in bytes of the renderer temporaries arena, placed in IWRAM:
+    static constexpr int render_arena_size()
+    {
+        return sizeof(render_arena);
+    }
+
+    // Maximum bytes of the renderer temporaries arena written since this
+    // object was created. The arena is filled with a pattern on creation, and
+    // each buffer is used up to its last byte which doesn't match it. Written
+    // bytes equal to the pattern can't be told apart, so it can fall a bit
+    // short. It scans the whole arena, so it's slow:
+    [[nodiscard]] int render_arena_high_water_mark() const;
+
+    // Size in bytes of the renderer data kept between update() calls, which
+    // can't be shared like the arena:
+    static constexpr int render_cache_size()
+    {
+        return sizeof(render_cache);
+    }
+
+    const render_governor &governor() const
+    {
+        return _render_governor;
+    }
+
+    // Number of update() calls whose previous frame depth order needed too
+    // many moves to be repaired, so a full sort was done:
+    int depth_sort_fallbacks_count() const
+    {
+        return _depth_sort_fallbacks_count;
+    }
+
+    // Number of update() calls whose visible faces count changed, so the
+    // previous frame depth order was resized before repairing it:
+    int depth_sort_resizes_count() const
+    {
+        return _depth_sort_resizes_count;
+    }
+
   private:
     static constexpr int _max_models =
         constants_3d::max_static_models + constants_3d::max_dynamic_models;
-    static constexpr int _max_vertices = 256;
-    static constexpr int _max_faces = 176;
+    static constexpr int _max_vertices = FR_MAX_VERTICES;
+    static constexpr int _max_faces = FR_MAX_FACES;
 
-    static_assert(_max_faces <= bn::numeric_limits<uint8_t>::max());
+    static_assert(_max_vertices > 0, "Invalid max vertices");
+    static_assert(_max_faces > 0 &&
+                      _max_faces <= bn::numeric_limits<uint16_t>::max(),
+                  "Invalid max faces");
 
-    struct point_2d
-    {
-        int16_t x;
-        int16_t y;
-    };
+    static constexpr bool _small_face_indexes =
+        _max_faces <= bn::numeric_limits<uint8_t>::max();
+
+    using face_index_type =
+        bn::conditional_t<_small_face_indexes, uint8_t, uint16_t>;
+
+    using point_2d = vertex_projection::point;
 
     struct vertex_2d
     {
@@ -130,10 +231,12 @@ class models_3d
 
     struct valid_face_info
     {
-        const face_3d *face;
+        const face_indexes_3d *indexes;
         const point_2d *projected_vertices;
         int projected_z;
-        int color_index_override = -1;
+        int16_t color_index;
+        int8_t shading;
+        bool triangle;
     };
 
     struct visible_face_info
@@ -146,30 +249,87 @@ class models_3d
         int16_t maximum_y;
     };
 
+    // Temporaries of _process_models, kept out of the stack:
+    struct render_arena
+    {
+        point_2d projected_vertices[_max_vertices];
+        valid_face_info valid_faces_info[_max_faces];
+        visible_face_info visible_faces_info[_max_faces];
+        uint16_t visible_face_depth_keys[_max_faces];
+        uint16_t temp_depth_keys[_max_faces];
+        face_index_type temp_visible_face_indexes[_max_faces];
+        uint16_t depth_sort_bucket_offsets[depth_sort::buckets];
+        shape_groups::hline hlines[bn::display::height()];
+    };
+
+    static_assert(sizeof(render_arena) <= FR_RENDER_ARENA_MAX_SIZE,
+                  "Render arena is over its IWRAM budget");
+
+    // Only one models_3d is updated at a time, so they share the same arena:
+    static render_arena _render_arena;
+
+    // Transformed faces of the dynamic models and the depth order of the last
+    // frame:
+    struct render_cache
+    {
+        point_3d transformed_face_centroids[_max_faces];
+        point_3d transformed_face_normals[_max_faces];
+        face_index_type sorted_visible_face_indexes[_max_faces];
+    };
+
     const model_3d_item **_static_model_items_ptr = nullptr;
     int _static_models_count = 0;
     int _static_vertices_count = 0;
     int _static_faces_count = 0;
+    int _retained_static_models_count = 0;
+    int _retained_static_vertices_count = 0;
+    int _retained_static_faces_count = 0;
 
     bn::pool<model_3d, constants_3d::max_dynamic_models> _dynamic_models_pool;
     bn::intrusive_list<model_3d> _dynamic_models_list;
     bn::pool<sprite_3d, constants_3d::max_sprites> _sprites_pool;
     bn::intrusive_list<sprite_3d> _sprites_list;
 
-    visible_face_info _visible_faces_info[_max_faces];
+    render_cache _render_cache;
+    int _sorted_visible_faces_count = 0;
+    int _depth_sort_fallbacks_count = 0;
+    int _depth_sort_resizes_count = 0;
     shape_groups _shape_groups;
+    render_governor _render_governor;
+    int _render_ticks = 0;
 
     scene_colors_generator::color_mapping_handler *_color_mapping;
 
     int _sprite_priority = 3;
     int _vertices_count = 0;
     int _faces_count = 0;
+    int _valid_faces_count = 0;
+    int _visible_faces_count = 0;
+    int _dropped_faces_count = 0;
 
 #if FR_LOG_POLYGONS_PER_SECOND
     int _total_faces_count = 0;
     int _update_calls = 0;
 #endif
 
+#if FR_LOG_RENDER_STATS
+    int _stats_total_valid_faces = 0;
+    int _stats_total_visible_faces = 0;
+    int _stats_total_hlines = 0;
+    int _stats_max_valid_faces = 0;
+    int _stats_max_visible_faces = 0;
+    int _stats_max_hlines = 0;
+    int _stats_depth_sort_fallbacks = 0;
+    int _stats_depth_sort_resizes = 0;
+    int _stats_total_dropped_faces = 0;
+    int _stats_update_calls = 0;
+#endif
+
+    void _update_static_counts(int static_vertices_count,
+                               int static_faces_count);
+
+    static void _fill_render_arena();
+
     BN_CODE_IWRAM void _process_models(const camera_3d &camera);
 };
 
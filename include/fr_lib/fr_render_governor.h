@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020-2024 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef FR_RENDER_GOVERNOR_H
+#define FR_RENDER_GOVERNOR_H
+
+#include "bn_timer.h"
+
+#include "fr_constants_3d.h"
+
+namespace fr
+{
+
+// Lowers render quality when the renderer goes over its CPU budget or drops
+// frames for some consecutive frames, and restores it after enough frames
+// with headroom.
+class render_governor
+{
+
+  public:
+    static constexpr int max_quality_level = 3;
+
+    // 0 is full quality, max_quality_level is the lowest one:
+    [[nodiscard]] int quality_level() const
+    {
+        return _quality_level;
+    }
+
+    // Depth multiplier used to pick model detail levels, with 4 fractional
+    // bits:
+    [[nodiscard]] int lod_depth_scale() const;
+
+    // Maximum number of sprites to render:
+    [[nodiscard]] int max_sprites() const;
+
+    // Maximum depth of the rendered models and sprites (with 8 fractional
+    // bits), or 0 if there's no limit:
+    [[nodiscard]] int far_depth() const;
+
+    // Renderer ticks of the last update() call:
+    [[nodiscard]] int render_ticks() const
+    {
+        return _render_ticks;
+    }
+
+    void update(int render_ticks);
+
+    // Called instead of update() on frames which don't render, so the time
+    // between updates isn't taken as a dropped frame:
+    void skip_frame()
+    {
+        _frame_timer_started = false;
+    }
+
+  private:
+    bn::timer _frame_timer;
+    int _quality_level = 0;
+    int _render_ticks = 0;
+    int _over_budget_frames = 0;
+    int _headroom_frames = 0;
+    bool _frame_timer_started = false;
+};
+
+} // namespace fr
+
+#endif
@@ -14,6 +14,7 @@
 #include "bn_sprite_tiles_ptr.h"
 #include "bn_sprite_palette_ptr.h"
 
+#include "fr_constants_3d.h"
 #include "fr_model_3d_item.h"
 
 namespace fr
@@ -31,12 +32,16 @@ namespace fr
             int xr;
         };
 
-        shape_groups();
+        // max_hdma_sprites is the number of hlines and sprites which can be drawn on each screen line
+        // (0 to constants_3d::max_hdma_sprites). HDMA buffers are allocated for it, so scenes with light 3D
+        // should ask for less. With 0, nothing is allocated nor drawn.
+        explicit shape_groups(int max_hdma_sprites);
 
-        ~shape_groups()
-        {
-            _clear();
-        }
+        ~shape_groups();
+
+        shape_groups(const shape_groups& other) = delete;
+
+        shape_groups& operator=(const shape_groups& other) = delete;
 
         void load_colors(const bn::span<const bn::color> &colors);
 
@@ -60,10 +65,26 @@ namespace fr
 
         void update();
 
+        // Keeps showing the last updated frame: HDMA keeps reading its buffer, which isn't written again until
+        // the next update() call.
+        void retain_last_frame()
+        {
+            _draw_enabled = false;
+        }
+
+        [[nodiscard]] int hlines_count() const
+        {
+            return _last_hlines_count;
+        }
+
+        // Sprites written by HDMA on each screen line in the last update() call:
+        [[nodiscard]] int hdma_sprites_count() const
+        {
+            return _last_hdma_sprites_count;
+        }
+
     private:
         static constexpr int _max_palettes = 8;
-        static constexpr int _max_hdma_sprites = 32;
-        static constexpr int _hdma_source_size = (bn::display::height() + 1) * 4 * _max_hdma_sprites;
 
         class color_tiles
         {
@@ -90,6 +111,28 @@ namespace fr
             void load(const color_tiles &color_tiles);
         };
 
+        // Last single sprite hline added to a screen line, so the next one can be merged with it:
+        class last_hline
+        {
+
+        public:
+            int16_t xl;
+            int16_t xr;
+            uint16_t key; // 0 if it can't be merged
+        };
+
+    #if FR_COVERAGE_BUFFER
+        // Disjoint screen intervals covered by hlines in a screen line, sorted by xl:
+        class coverage_line
+        {
+
+        public:
+            int16_t xls[FR_COVERAGE_MAX_INTERVALS];
+            int16_t xrs[FR_COVERAGE_MAX_INTERVALS];
+            int count;
+        };
+    #endif
+
         alignas(int) bn::vector<color_tiles, face_3d::max_colors> _color_tiles;
         alignas(int) color_tiles_ids _color_tiles_ids[face_3d::max_colors];
         alignas(int) bn::color _colors[face_3d::max_colors];
@@ -98,17 +141,29 @@ namespace fr
         alignas(int) uint8_t _palette_ids[_max_palettes];
 
         alignas(int) uint8_t _hlines_count[bn::display::height()] = {};
-        alignas(int) uint8_t _previous_hlines_count_a[bn::display::height()] = {};
-        alignas(int) uint8_t _previous_hlines_count_b[bn::display::height()] = {};
+        alignas(int) last_hline _last_hlines[bn::display::height()] = {};
 
-        alignas(int) uint16_t _hdma_source_a[_hdma_source_size];
-        alignas(int) uint16_t _hdma_source_b[_hdma_source_size];
-        uint16_t *_hdma_source = _hdma_source_a;
+    #if FR_COVERAGE_BUFFER
+        alignas(int) coverage_line _coverage_lines[bn::display::height()] = {};
+    #endif
+
+        int _max_hdma_sprites;
+        uint16_t *_hdma_source_a = nullptr;
+        uint16_t *_hdma_source_b = nullptr;
+        uint16_t *_hdma_source = nullptr;
 
         int _sprite_priority = 3;
+        int _last_hlines_count = 0;
+        int _last_peak_hlines_count;
+        int _last_hdma_sprites_count = 0;
         bool _draw_enabled = false;
 
-        BN_CODE_IWRAM void _hide_left_hlines(const uint8_t *previous_hlines_count);
+        BN_CODE_IWRAM void _pack_hlines(int hdma_sprites_count);
+
+        BN_CODE_IWRAM bool _cover_hline(unsigned y, int xl, int xr);
+
+        BN_CODE_IWRAM bool _merge_hline(unsigned y, int xl, int xr, unsigned key, const color_tiles_ids &tiles_ids,
+                                        int palette_id);
 
         void _clear();
     };
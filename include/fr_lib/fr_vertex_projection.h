@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2020-2024 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef FR_VERTEX_PROJECTION_H
+#define FR_VERTEX_PROJECTION_H
+
+#include "bn_display.h"
+
+#include "fr_constants_3d.h"
+#include "fr_div_lut.h"
+#include "fr_point_3d.h"
+
+// Projection of static and translation only vertices, used by models_3d.
+// project() is the C++ reference of the ARM kernel in fr_project_vertices.s,
+// and both must give the same output:
+namespace fr::vertex_projection
+{
+
+constexpr int near_plane = 24 * 256 * 16;
+
+class point
+{
+
+  public:
+    int16_t x;
+    int16_t y;
+};
+
+// fr_project_vertices parameters, its layout is hardcoded in the kernel.
+// Vertices are moved by -offset before being rotated by the camera axes:
+class params
+{
+
+  public:
+    int offset_x;
+    int offset_y;
+    int offset_z;
+    int u_x;
+    int u_y;
+    int u_z;
+    int v_x;
+    int v_y;
+    int v_z;
+    int w_x;
+    int w_y;
+    int w_z;
+    const uint32_t *div_lut;
+};
+
+static_assert(sizeof(point) == 4);
+static_assert(sizeof(params) == 12 * 4 + sizeof(const uint32_t *));
+static_assert(sizeof(vertex_3d) == 16);
+
+// Projects the given point. Returns false if it is behind the near plane:
+[[nodiscard]] inline bool project_point(const point_3d &model_point,
+                                        const params &params,
+                                        point &projected_vertex)
+{
+    constexpr int focal_length_shift = constants_3d::focal_length_shift;
+
+    bn::fixed u_x = bn::fixed::from_data(params.u_x);
+    bn::fixed u_y = bn::fixed::from_data(params.u_y);
+    bn::fixed u_z = bn::fixed::from_data(params.u_z);
+    bn::fixed v_x = bn::fixed::from_data(params.v_x);
+    bn::fixed v_y = bn::fixed::from_data(params.v_y);
+    bn::fixed v_z = bn::fixed::from_data(params.v_z);
+    bn::fixed w_x = bn::fixed::from_data(params.w_x);
+    bn::fixed w_y = bn::fixed::from_data(params.w_y);
+    bn::fixed w_z = bn::fixed::from_data(params.w_z);
+
+    // Bit shifting to avoid overflow
+    bn::fixed vrx = bn::fixed::from_data((model_point.x().data() - params.offset_x) >> 4);
+    bn::fixed vry = bn::fixed::from_data((model_point.y().data() - params.offset_y) >> 4);
+    bn::fixed vrz = bn::fixed::from_data((model_point.z().data() - params.offset_z) >> 4);
+
+    int vcz = -(vrx.unsafe_multiplication(w_x) +
+                vry.unsafe_multiplication(w_y) +
+                vrz.unsafe_multiplication(w_z)).data() << 4;
+
+    if (near_plane > vcz) [[unlikely]]
+    {
+        return false;
+    }
+
+    int vcx = (vrx.unsafe_multiplication(u_x) +
+               vry.unsafe_multiplication(u_y) +
+               vrz.unsafe_multiplication(u_z))
+                  .data();
+    int vcy = -(vrx.unsafe_multiplication(v_x) +
+                vry.unsafe_multiplication(v_y) +
+                vrz.unsafe_multiplication(v_z))
+                   .data();
+
+    // int scale = (1 << (focal_length_shift + 16 + 4)) / vcz;
+    auto scale = int(
+        (params.div_lut[vcz >> 10] << (focal_length_shift - 8)) >> 6);
+
+    projected_vertex = {
+        int16_t(((vcx * scale) >> 16) + (bn::display::width() / 2)),
+        int16_t(((vcy * scale) >> 16) + (bn::display::height() / 2))};
+    return true;
+}
+
+// Projects the given vertices until it finds the first one behind the near
+// plane. Returns the number of projected vertices:
+[[nodiscard]] inline int project(const vertex_3d *vertices, int vertices_count,
+                                 point *projected_vertices,
+                                 const params &params)
+{
+    for (int index = 0; index < vertices_count; ++index)
+    {
+        if (!project_point(vertices[index].point(), params,
+                           projected_vertices[index])) [[unlikely]]
+        {
+            return index;
+        }
+    }
+
+    return vertices_count;
+}
+
+} // namespace fr::vertex_projection
+
+#endif
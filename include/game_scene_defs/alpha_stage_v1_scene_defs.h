@@ -5,6 +5,8 @@
 
 #include "scene_colors_generator.h"
 #include "stage_section.h"
+#include "stage_event.h"
+#include "stage_budget.h"
 #include "static_model_3d_item.h"
 #include "enemy_def.h"
 #include "bn_color.h"
@@ -292,6 +294,89 @@ constexpr const auto sections_full = {
 constexpr stage_section_list_ptr sections = sections_full.begin();
 constexpr size_t sections_count = sections_full.size();
 
+// # Events
+
+constexpr stage_event stage_events[] = {
+    {1050, stage_event_type::SPAWN, 0},
+    {750, stage_event_type::SPAWN, 1},
+    {450, stage_event_type::SPAWN, 2},
+    {250, stage_event_type::DESPAWN, 0},
+    {50, stage_event_type::SPAWN, 3},
+    {-150, stage_event_type::DESPAWN, 1},
+    {-350, stage_event_type::DESPAWN, 2},
+    {-450, stage_event_type::SPAWN, 4},
+    {-750, stage_event_type::DESPAWN, 3},
+    {-950, stage_event_type::SPAWN, 5},
+    {-1450, stage_event_type::SPAWN, 6},
+    {-1650, stage_event_type::SPAWN, 7},
+    {-1950, stage_event_type::SPAWN, 8},
+    {-2350, stage_event_type::DESPAWN, 4},
+    {-2350, stage_event_type::DESPAWN, 6},
+    {-2450, stage_event_type::SPAWN, 9},
+    {-2550, stage_event_type::DESPAWN, 7},
+    {-2850, stage_event_type::DESPAWN, 5},
+    {-2850, stage_event_type::DESPAWN, 8},
+    {-3050, stage_event_type::SPAWN, 10},
+    {-3750, stage_event_type::DESPAWN, 9},
+    {-3950, stage_event_type::SPAWN, 11},
+    {-4250, stage_event_type::DESPAWN, 10},
+    {-5000, stage_event_type::DESPAWN, 11},
+    {-5400, stage_event_type::SPAWN, 13},
+    {-6400, stage_event_type::DESPAWN, 13}
+};
+
+// # Budget
+
+constexpr stage_band_budget stage_band_budgets[] = {
+    stage_band_budget(sections, sections_count, 1050, 750),
+    stage_band_budget(sections, sections_count, 750, 450),
+    stage_band_budget(sections, sections_count, 450, 250),
+    stage_band_budget(sections, sections_count, 250, 50),
+    stage_band_budget(sections, sections_count, 50, -150),
+    stage_band_budget(sections, sections_count, -150, -350),
+    stage_band_budget(sections, sections_count, -350, -450),
+    stage_band_budget(sections, sections_count, -450, -750),
+    stage_band_budget(sections, sections_count, -750, -950),
+    stage_band_budget(sections, sections_count, -950, -1450),
+    stage_band_budget(sections, sections_count, -1450, -1650),
+    stage_band_budget(sections, sections_count, -1650, -1950),
+    stage_band_budget(sections, sections_count, -1950, -2350),
+    stage_band_budget(sections, sections_count, -2350, -2450),
+    stage_band_budget(sections, sections_count, -2450, -2550),
+    stage_band_budget(sections, sections_count, -2550, -2850),
+    stage_band_budget(sections, sections_count, -2850, -3050),
+    stage_band_budget(sections, sections_count, -3050, -3750),
+    stage_band_budget(sections, sections_count, -3750, -3950),
+    stage_band_budget(sections, sections_count, -3950, -4250),
+    stage_band_budget(sections, sections_count, -4250, -5000),
+    stage_band_budget(sections, sections_count, -5000, -5350),
+    stage_band_budget(sections, sections_count, -5400, -6400)
+};
+
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[0], "Band 1050..750");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[1], "Band 750..450");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[2], "Band 450..250");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[3], "Band 250..50");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[4], "Band 50..-150");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[5], "Band -150..-350");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[6], "Band -350..-450");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[7], "Band -450..-750");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[8], "Band -750..-950");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[9], "Band -950..-1450");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[10], "Band -1450..-1650");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[11], "Band -1650..-1950");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[12], "Band -1950..-2350");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[13], "Band -2350..-2450");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[14], "Band -2450..-2550");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[15], "Band -2550..-2850");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[16], "Band -2850..-3050");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[17], "Band -3050..-3750");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[18], "Band -3750..-3950");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[19], "Band -3950..-4250");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[20], "Band -4250..-5000");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[21], "Band -5000..-5350");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[22], "Band -5400..-6400");
+
 // --- Colors
 
 constexpr const auto raw_scene_colors = {
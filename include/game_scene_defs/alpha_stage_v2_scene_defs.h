@@ -5,6 +5,8 @@
 
 #include "scene_colors_generator.h"
 #include "stage_section.h"
+#include "stage_event.h"
+#include "stage_budget.h"
 #include "static_model_3d_item.h"
 #include "enemy_def.h"
 #include "bn_color.h"
@@ -439,6 +441,127 @@ constexpr const auto sections_full = {
 constexpr stage_section_list_ptr sections = sections_full.begin();
 constexpr size_t sections_count = sections_full.size();
 
+// # Events
+
+constexpr stage_event stage_events[] = {
+    {1050, stage_event_type::SPAWN, 0},
+    {750, stage_event_type::SPAWN, 1},
+    {450, stage_event_type::SPAWN, 2},
+    {250, stage_event_type::DESPAWN, 0},
+    {50, stage_event_type::SPAWN, 3},
+    {-150, stage_event_type::DESPAWN, 1},
+    {-350, stage_event_type::DESPAWN, 2},
+    {-450, stage_event_type::SPAWN, 4},
+    {-750, stage_event_type::DESPAWN, 3},
+    {-950, stage_event_type::SPAWN, 5},
+    {-1450, stage_event_type::SPAWN, 6},
+    {-1650, stage_event_type::SPAWN, 7},
+    {-1850, stage_event_type::SPAWN, 8},
+    {-2350, stage_event_type::DESPAWN, 4},
+    {-2350, stage_event_type::DESPAWN, 6},
+    {-2550, stage_event_type::DESPAWN, 7},
+    {-2650, stage_event_type::SPAWN, 10},
+    {-2850, stage_event_type::DESPAWN, 5},
+    {-2850, stage_event_type::DESPAWN, 8},
+    {-2950, stage_event_type::SPAWN, 11},
+    {-3150, stage_event_type::SPAWN, 12},
+    {-3550, stage_event_type::SPAWN, 13},
+    {-3750, stage_event_type::SPAWN, 14},
+    {-3850, stage_event_type::DESPAWN, 11},
+    {-3950, stage_event_type::DESPAWN, 10},
+    {-4050, stage_event_type::DESPAWN, 12},
+    {-4600, stage_event_type::DESPAWN, 13},
+    {-4750, stage_event_type::SPAWN, 16},
+    {-4850, stage_event_type::DESPAWN, 14},
+    {-4850, stage_event_type::SPAWN, 17},
+    {-5350, stage_event_type::SPAWN, 18},
+    {-5750, stage_event_type::SPAWN, 19},
+    {-5900, stage_event_type::DESPAWN, 16},
+    {-6000, stage_event_type::DESPAWN, 17},
+    {-6350, stage_event_type::SPAWN, 20},
+    {-6500, stage_event_type::DESPAWN, 18},
+    {-6900, stage_event_type::DESPAWN, 19},
+    {-7300, stage_event_type::DESPAWN, 20}
+};
+
+// # Budget
+
+constexpr stage_band_budget stage_band_budgets[] = {
+    stage_band_budget(sections, sections_count, 1050, 750),
+    stage_band_budget(sections, sections_count, 750, 450),
+    stage_band_budget(sections, sections_count, 450, 250),
+    stage_band_budget(sections, sections_count, 250, 50),
+    stage_band_budget(sections, sections_count, 50, -150),
+    stage_band_budget(sections, sections_count, -150, -350),
+    stage_band_budget(sections, sections_count, -350, -450),
+    stage_band_budget(sections, sections_count, -450, -750),
+    stage_band_budget(sections, sections_count, -750, -950),
+    stage_band_budget(sections, sections_count, -950, -1450),
+    stage_band_budget(sections, sections_count, -1450, -1650),
+    stage_band_budget(sections, sections_count, -1650, -1850),
+    stage_band_budget(sections, sections_count, -1850, -2350),
+    stage_band_budget(sections, sections_count, -2350, -2550),
+    stage_band_budget(sections, sections_count, -2550, -2650),
+    stage_band_budget(sections, sections_count, -2650, -2850),
+    stage_band_budget(sections, sections_count, -2850, -2950),
+    stage_band_budget(sections, sections_count, -2950, -3150),
+    stage_band_budget(sections, sections_count, -3150, -3550),
+    stage_band_budget(sections, sections_count, -3550, -3750),
+    stage_band_budget(sections, sections_count, -3750, -3850),
+    stage_band_budget(sections, sections_count, -3850, -3950),
+    stage_band_budget(sections, sections_count, -3950, -4050),
+    stage_band_budget(sections, sections_count, -4050, -4550),
+    stage_band_budget(sections, sections_count, -4550, -4600),
+    stage_band_budget(sections, sections_count, -4600, -4750),
+    stage_band_budget(sections, sections_count, -4750, -4850),
+    stage_band_budget(sections, sections_count, -4850, -5350),
+    stage_band_budget(sections, sections_count, -5350, -5600),
+    stage_band_budget(sections, sections_count, -5600, -5750),
+    stage_band_budget(sections, sections_count, -5750, -5900),
+    stage_band_budget(sections, sections_count, -5900, -6000),
+    stage_band_budget(sections, sections_count, -6000, -6350),
+    stage_band_budget(sections, sections_count, -6350, -6500),
+    stage_band_budget(sections, sections_count, -6500, -6900),
+    stage_band_budget(sections, sections_count, -6900, -7300)
+};
+
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[0], "Band 1050..750");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[1], "Band 750..450");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[2], "Band 450..250");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[3], "Band 250..50");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[4], "Band 50..-150");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[5], "Band -150..-350");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[6], "Band -350..-450");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[7], "Band -450..-750");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[8], "Band -750..-950");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[9], "Band -950..-1450");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[10], "Band -1450..-1650");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[11], "Band -1650..-1850");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[12], "Band -1850..-2350");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[13], "Band -2350..-2550");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[14], "Band -2550..-2650");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[15], "Band -2650..-2850");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[16], "Band -2850..-2950");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[17], "Band -2950..-3150");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[18], "Band -3150..-3550");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[19], "Band -3550..-3750");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[20], "Band -3750..-3850");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[21], "Band -3850..-3950");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[22], "Band -3950..-4050");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[23], "Band -4050..-4550");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[24], "Band -4550..-4600");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[25], "Band -4600..-4750");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[26], "Band -4750..-4850");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[27], "Band -4850..-5350");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[28], "Band -5350..-5600");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[29], "Band -5600..-5750");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[30], "Band -5750..-5900");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[31], "Band -5900..-6000");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[32], "Band -6000..-6350");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[33], "Band -6350..-6500");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[34], "Band -6500..-6900");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[35], "Band -6900..-7300");
+
 // --- Colors
 
 constexpr const auto raw_scene_colors = {
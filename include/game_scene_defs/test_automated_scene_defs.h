@@ -5,6 +5,8 @@
 
 #include "scene_colors_generator.h"
 #include "stage_section.h"
+#include "stage_event.h"
+#include "stage_budget.h"
 #include "static_model_3d_item.h"
 #include "enemy_def.h"
 #include "bn_color.h"
@@ -82,6 +84,33 @@ constexpr const auto sections_full = {
 constexpr stage_section_list_ptr sections = sections_full.begin();
 constexpr size_t sections_count = sections_full.size();
 
+// # Events
+
+constexpr stage_event stage_events[] = {
+    {1050, stage_event_type::SPAWN, 0},
+    {750, stage_event_type::SPAWN, 1},
+    {350, stage_event_type::SPAWN, 2},
+    {200, stage_event_type::DESPAWN, 0},
+    {-150, stage_event_type::DESPAWN, 1},
+    {-700, stage_event_type::DESPAWN, 2}
+};
+
+// # Budget
+
+constexpr stage_band_budget stage_band_budgets[] = {
+    stage_band_budget(sections, sections_count, 1050, 750),
+    stage_band_budget(sections, sections_count, 750, 350),
+    stage_band_budget(sections, sections_count, 350, 200),
+    stage_band_budget(sections, sections_count, 200, -150),
+    stage_band_budget(sections, sections_count, -150, -700)
+};
+
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[0], "Band 1050..750");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[1], "Band 750..350");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[2], "Band 350..200");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[3], "Band 200..-150");
+STAGE_BAND_BUDGET_CHECK(stage_band_budgets[4], "Band -150..-700");
+
 // --- Colors
 
 constexpr const auto raw_scene_colors = {
@@ -0,0 +1,260 @@
+
+#ifndef MERGED_STATIC_MODEL_3D_ITEM_H
+#define MERGED_STATIC_MODEL_3D_ITEM_H
+
+#include "bn_array.h"
+#include "bn_color.h"
+#include "bn_span.h"
+#include "bn_utility.h"
+
+#include "fr_constants_3d.h"
+#include "fr_model_3d_item.h"
+
+// Number of vertices of the given items after merging the equal ones:
+[[nodiscard]] constexpr int merged_vertices_count(
+    const bn::span<const fr::model_3d_item> &items)
+{
+    int result = 0;
+
+    for (int item_index = 0; item_index < items.size(); ++item_index)
+    {
+        const bn::span<const fr::vertex_3d> &vertices =
+            items[item_index].vertices();
+
+        for (int vertex_index = 0; vertex_index < vertices.size();
+             ++vertex_index)
+        {
+            const fr::point_3d &point = vertices[vertex_index].point();
+            bool repeated = false;
+
+            for (int other_item_index = 0;
+                 other_item_index <= item_index && !repeated;
+                 ++other_item_index)
+            {
+                const bn::span<const fr::vertex_3d> &other_vertices =
+                    items[other_item_index].vertices();
+                int other_vertices_count = other_item_index == item_index
+                                               ? vertex_index
+                                               : other_vertices.size();
+
+                for (int other_vertex_index = 0;
+                     other_vertex_index < other_vertices_count;
+                     ++other_vertex_index)
+                {
+                    if (other_vertices[other_vertex_index].point() == point)
+                    {
+                        repeated = true;
+                        break;
+                    }
+                }
+            }
+
+            if (!repeated)
+            {
+                ++result;
+            }
+        }
+    }
+
+    return result;
+}
+
+// Welds the given static model items (the ones of a stage section, for
+// example) into a single model_3d_item with shared vertices, so the renderer
+// processes them as one model. Each input item becomes a sub-range of the
+// merged item with its own faces, clusters, palette and collision data (see
+// model_3d_sub_range).
+//
+// Lower detail levels of the input items are not kept.
+template <const auto &items> class merged_static_model_3d_item
+{
+  public:
+    constexpr merged_static_model_3d_item()
+        : _vertices(_create_array<fr::vertex_3d, vertices_count>(
+              items[0].vertices()[0])),
+          _faces(_create_array<fr::face_3d, faces_count>(items[0].faces()[0])),
+          _collision_faces(_create_array<fr::face_3d, sub_ranges_count>(
+              items[0].faces()[0]))
+    {
+        int merged_count = 0;
+        int first_face_index = 0;
+        int first_cluster_index = 0;
+
+        for (int item_index = 0; item_index < sub_ranges_count; ++item_index)
+        {
+            const fr::model_3d_item &item = items[item_index];
+            const bn::span<const fr::vertex_3d> &item_vertices =
+                item.vertices();
+            const bn::span<const fr::face_3d> &item_faces = item.faces();
+            const bn::span<const fr::face_cluster_3d> &item_clusters =
+                item.face_clusters();
+            int vertex_indexes[max_item_vertices_count] = {};
+
+            for (int index = 0; index < item_vertices.size(); ++index)
+            {
+                const fr::vertex_3d &vertex = item_vertices[index];
+                int merged_index = 0;
+
+                while (merged_index < merged_count &&
+                       !(_vertices[merged_index].point() == vertex.point()))
+                {
+                    ++merged_index;
+                }
+
+                if (merged_index == merged_count)
+                {
+                    _vertices[merged_count] = vertex;
+                    ++merged_count;
+                }
+
+                vertex_indexes[index] = merged_index;
+            }
+
+            bn::span<const fr::vertex_3d> merged_vertices(_vertices.data(),
+                                                          merged_count);
+
+            for (int index = 0; index < item_faces.size(); ++index)
+            {
+                _faces[first_face_index + index] = _merged_face(
+                    item_faces[index], merged_vertices, vertex_indexes);
+            }
+
+            bn::span<const fr::face_3d> merged_faces(_faces.data(),
+                                                     faces_count);
+
+            for (int index = 0; index < item_clusters.size(); ++index)
+            {
+                const fr::face_cluster_3d &cluster = item_clusters[index];
+                _face_clusters[first_cluster_index + index] =
+                    fr::face_cluster_3d(
+                        merged_faces,
+                        first_face_index + cluster.first_face_index(),
+                        cluster.faces_count());
+            }
+
+            // Collision faces reference the merged vertices too:
+            const fr::face_3d *collision_face = nullptr;
+
+            if (const fr::face_3d *item_collision_face = item.collision_face())
+            {
+                _collision_faces[item_index] = _merged_face(
+                    *item_collision_face, merged_vertices, vertex_indexes);
+                collision_face = &_collision_faces[item_index];
+            }
+
+            const fr::model_3d_vertical_cylinder *vertical_cylinder = nullptr;
+
+            if (const fr::model_3d_vertical_cylinder *item_vertical_cylinder =
+                    item.vertical_cylinder())
+            {
+                _vertical_cylinders[item_index] = *item_vertical_cylinder;
+                vertical_cylinder = &_vertical_cylinders[item_index];
+            }
+
+            _sub_ranges[item_index] = fr::model_3d_sub_range(
+                first_face_index, item_faces.size(), first_cluster_index,
+                item_clusters.size(), item.palette(), collision_face,
+                vertical_cylinder);
+            first_face_index += item_faces.size();
+            first_cluster_index += item_clusters.size();
+        }
+    }
+
+    [[nodiscard]] constexpr fr::model_3d_item item() const
+    {
+        return fr::model_3d_item(
+            _vertices, _faces, nullptr, nullptr, nullptr, nullptr, 0, nullptr,
+            bn::span<const fr::face_cluster_3d>(_face_clusters.data(),
+                                                clusters_count),
+            _sub_ranges);
+    }
+
+  private:
+    static constexpr int sub_ranges_count = sizeof(items) / sizeof(items[0]);
+    static constexpr int vertices_count = merged_vertices_count(items);
+
+    static constexpr int faces_count = [] {
+        int result = 0;
+
+        for (const fr::model_3d_item &item : items)
+        {
+            result += item.faces().size();
+        }
+
+        return result;
+    }();
+
+    static constexpr int clusters_count = [] {
+        int result = 0;
+
+        for (const fr::model_3d_item &item : items)
+        {
+            result += item.face_clusters().size();
+        }
+
+        return result;
+    }();
+
+    static constexpr int max_item_vertices_count = [] {
+        int result = 0;
+
+        for (const fr::model_3d_item &item : items)
+        {
+            result = bn::max(result, item.vertices().size());
+        }
+
+        return result;
+    }();
+
+    // Models whose vertices don't fit are not rendered:
+    static_assert(vertices_count <= FR_MAX_VERTICES,
+                  "Merged model has too many vertices");
+
+    bn::array<fr::vertex_3d, vertices_count> _vertices;
+    bn::array<fr::face_3d, faces_count> _faces;
+    bn::array<fr::face_cluster_3d, bn::max(clusters_count, 1)> _face_clusters;
+    bn::array<fr::model_3d_sub_range, sub_ranges_count> _sub_ranges;
+    bn::array<fr::face_3d, sub_ranges_count> _collision_faces;
+    bn::array<fr::model_3d_vertical_cylinder, sub_ranges_count>
+        _vertical_cylinders;
+
+    // Returns the given item face with its vertices moved to the merged ones:
+    [[nodiscard]] static constexpr fr::face_3d _merged_face(
+        const fr::face_3d &face,
+        const bn::span<const fr::vertex_3d> &merged_vertices,
+        const int *vertex_indexes)
+    {
+        int first_vertex_index = vertex_indexes[face.first_vertex_index()];
+        int second_vertex_index = vertex_indexes[face.second_vertex_index()];
+        int third_vertex_index = vertex_indexes[face.third_vertex_index()];
+
+        if (face.triangle())
+        {
+            return fr::face_3d(merged_vertices, face.normal(),
+                               first_vertex_index, second_vertex_index,
+                               third_vertex_index, face.color_index(),
+                               face.shading());
+        }
+
+        return fr::face_3d(merged_vertices, face.normal(), first_vertex_index,
+                           second_vertex_index, third_vertex_index,
+                           vertex_indexes[face.fourth_vertex_index()],
+                           face.color_index(), face.shading());
+    }
+
+    template <typename Type, unsigned Size>
+    [[nodiscard]] static constexpr bn::array<Type, Size> _create_array(
+        const Type &value)
+    {
+        return _create_array_impl(value, bn::make_index_sequence<Size>());
+    }
+
+    template <typename Type, unsigned... IndexSequence>
+    [[nodiscard]] static constexpr bn::array<Type, sizeof...(IndexSequence)>
+    _create_array_impl(Type value, bn::index_sequence<IndexSequence...>)
+    {
+        return {{(static_cast<void>(IndexSequence), value)...}};
+    }
+};
+
+#endif
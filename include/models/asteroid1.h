@@ -29,11 +29,13 @@
     constexpr inline face_3d asteroid1_faces_full[] = {
         face_3d(asteroid1_vertices, vertex_3d(-0.9911,-0.1327,-0.0107),3,2,1,0,3),
         face_3d(asteroid1_vertices, vertex_3d(0.0148,0.9984,0.0546),0,1,2,0,0),
-        face_3d(asteroid1_vertices, vertex_3d(0.2512,-0.2857,0.9248),3,0,2,0,4),
+        face_3d(asteroid1_vertices, vertex_3d(0.4888,0.6382,-0.5948),4,1,0,0,1),
         face_3d(asteroid1_vertices, vertex_3d(-0.5309,-0.6031,-0.5953),1,4,3,0,5),
         face_3d(asteroid1_vertices, vertex_3d(0.6196,-0.7048,0.3455),3,4,0,0,6),
-        face_3d(asteroid1_vertices, vertex_3d(0.4888,0.6382,-0.5948),4,1,0,0,1),
+        face_3d(asteroid1_vertices, vertex_3d(0.2512,-0.2857,0.9248),3,0,2,0,4),
     };
-    constexpr inline model_3d_item asteroid1_full(asteroid1_vertices, asteroid1_faces_full, asteroid1_colors);
+    constexpr inline int asteroid1_full_cluster_faces_counts[] = {1,2,2,1};
+    constexpr inline face_clusters_3d_array<4> asteroid1_full_face_clusters(asteroid1_faces_full, asteroid1_full_cluster_faces_counts);
+    constexpr inline model_3d_item asteroid1_full(asteroid1_vertices, asteroid1_faces_full, nullptr, nullptr, asteroid1_colors, nullptr, 0, nullptr, asteroid1_full_face_clusters.clusters());
     };
-#endif // FR_MODEL_3D_ITEMS_ASTEROID1_H
\ No newline at end of file
+#endif // FR_MODEL_3D_ITEMS_ASTEROID1_H
\ No newline at end of file
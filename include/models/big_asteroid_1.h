@@ -35,29 +35,33 @@
     constexpr inline int big_asteroid_1_color_0 = 0;
 
     constexpr inline face_3d big_asteroid_1_faces_full[] = {
-        face_3d(big_asteroid_1_vertices, vertex_3d(0.2249,-0.0000,-0.9744),0,5,1,0,5),
-        face_3d(big_asteroid_1_vertices, vertex_3d(0.2541,-0.0923,-0.9628),1,5,2,0,2),
-        face_3d(big_asteroid_1_vertices, vertex_3d(0.6029,-0.7425,-0.2919),2,6,4,0,1),
         face_3d(big_asteroid_1_vertices, vertex_3d(0.8391,-0.5076,-0.1954),5,6,2,0,3),
         face_3d(big_asteroid_1_vertices, vertex_3d(0.8588,0.1584,0.4873),5,8,9,0,4),
-        face_3d(big_asteroid_1_vertices, vertex_3d(0.5474,-0.3340,0.7673),9,7,6,0,3),
-        face_3d(big_asteroid_1_vertices, vertex_3d(-0.2673,-0.4601,0.8467),9,10,7,0,2),
-        face_3d(big_asteroid_1_vertices, vertex_3d(-0.6886,-0.0562,0.7230),9,12,11,0,4),
+        face_3d(big_asteroid_1_vertices, vertex_3d(0.7186,0.6936,0.0492),5,3,8,0,5),
+        face_3d(big_asteroid_1_vertices, vertex_3d(0.8277,0.3072,0.4696),5,9,6,0,5),
         face_3d(big_asteroid_1_vertices, vertex_3d(-0.8282,-0.5216,-0.2048),11,1,10,0,2),
-        face_3d(big_asteroid_1_vertices, vertex_3d(-0.4704,-0.8554,-0.2167),10,1,4,0,1),
         face_3d(big_asteroid_1_vertices, vertex_3d(-0.8598,-0.0000,-0.5106),11,0,1,0,4),
+        face_3d(big_asteroid_1_vertices, vertex_3d(-0.8282,0.5216,-0.2048),11,12,0,0,5),
         face_3d(big_asteroid_1_vertices, vertex_3d(-0.0811,0.9892,0.1217),8,3,12,0,7),
-        face_3d(big_asteroid_1_vertices, vertex_3d(0.3272,0.3661,-0.8712),0,3,5,0,6),
-        face_3d(big_asteroid_1_vertices, vertex_3d(0.2737,-0.4300,-0.8603),4,1,2,0,0),
+        face_3d(big_asteroid_1_vertices, vertex_3d(-0.4704,0.8554,-0.2167),12,3,0,0,5),
+        face_3d(big_asteroid_1_vertices, vertex_3d(0.6029,-0.7425,-0.2919),2,6,4,0,1),
+        face_3d(big_asteroid_1_vertices, vertex_3d(-0.4704,-0.8554,-0.2167),10,1,4,0,1),
         face_3d(big_asteroid_1_vertices, vertex_3d(0.2301,-0.9675,0.1047),6,7,4,0,2),
-        face_3d(big_asteroid_1_vertices, vertex_3d(0.7186,0.6936,0.0492),5,3,8,0,5),
-        face_3d(big_asteroid_1_vertices, vertex_3d(0.8277,0.3072,0.4696),5,9,6,0,5),
+        face_3d(big_asteroid_1_vertices, vertex_3d(-0.0811,-0.9892,0.1217),4,7,10,0,0),
+        face_3d(big_asteroid_1_vertices, vertex_3d(0.5474,-0.3340,0.7673),9,7,6,0,3),
+        face_3d(big_asteroid_1_vertices, vertex_3d(-0.2673,-0.4601,0.8467),9,10,7,0,2),
+        face_3d(big_asteroid_1_vertices, vertex_3d(-0.6886,-0.0562,0.7230),9,12,11,0,4),
         face_3d(big_asteroid_1_vertices, vertex_3d(-0.2673,0.4601,0.8467),9,8,12,0,5),
         face_3d(big_asteroid_1_vertices, vertex_3d(-0.6886,0.0562,0.7230),9,11,10,0,5),
-        face_3d(big_asteroid_1_vertices, vertex_3d(-0.8282,0.5216,-0.2048),11,12,0,0,5),
-        face_3d(big_asteroid_1_vertices, vertex_3d(-0.4704,0.8554,-0.2167),12,3,0,0,5),
-        face_3d(big_asteroid_1_vertices, vertex_3d(-0.0811,-0.9892,0.1217),4,7,10,0,0),
+        face_3d(big_asteroid_1_vertices, vertex_3d(0.2249,-0.0000,-0.9744),0,5,1,0,5),
+        face_3d(big_asteroid_1_vertices, vertex_3d(0.2541,-0.0923,-0.9628),1,5,2,0,2),
+        face_3d(big_asteroid_1_vertices, vertex_3d(0.3272,0.3661,-0.8712),0,3,5,0,6),
+        face_3d(big_asteroid_1_vertices, vertex_3d(0.2737,-0.4300,-0.8603),4,1,2,0,0),
     };
-    constexpr inline model_3d_item big_asteroid_1_full(big_asteroid_1_vertices, big_asteroid_1_faces_full, big_asteroid_1_colors);
+    constexpr inline packed_faces_3d_array<22> big_asteroid_1_full_packed_faces_array(big_asteroid_1_faces_full);
+    constexpr inline packed_faces_3d big_asteroid_1_full_packed_faces(big_asteroid_1_full_packed_faces_array);
+    constexpr inline int big_asteroid_1_full_cluster_faces_counts[] = {4,3,2,4,5,4};
+    constexpr inline face_clusters_3d_array<6> big_asteroid_1_full_face_clusters(big_asteroid_1_faces_full, big_asteroid_1_full_cluster_faces_counts);
+    constexpr inline model_3d_item big_asteroid_1_full(big_asteroid_1_vertices, big_asteroid_1_faces_full, nullptr, nullptr, big_asteroid_1_colors, nullptr, 0, &big_asteroid_1_full_packed_faces, big_asteroid_1_full_face_clusters.clusters());
     };
 #endif // FR_MODEL_3D_ITEMS_BIG_ASTEROID_1_H
\ No newline at end of file
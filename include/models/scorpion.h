@@ -48,6 +48,98 @@
     constexpr inline int scorpion_color_0 = 0;
     constexpr inline int scorpion_color_1 = 1;
 
+    constexpr inline vertex_3d scorpion_lod_2_vertices[] = {
+             vertex_3d(4.06644,0.02535,-4.6854975),
+             vertex_3d(-4.6720725000000005,-2.5969125,-6.424507500000001),
+             vertex_3d(-2.57688,0.0,-16.5909),
+             vertex_3d(-19.25607,0.0,-4.716105),
+             vertex_3d(-20.761245000000002,0.9665474999999999,2.35806),
+             vertex_3d(-5.980574999999999,-3.116305,4.283),
+             vertex_3d(-2.57688,0.0,16.5909),
+             vertex_3d(-4.6720725000000005,2.9771400000000003,-6.4245),
+             vertex_3d(3.20831625,1.18777125,2.3427525),
+             vertex_3d(-5.6605275,2.6794200000000004,3.2122537500000004),
+             vertex_3d(-35.935245,0.0,0.0),
+             vertex_3d(-21.877785,-1.687995,0.0),
+             vertex_3d(0.0,-4.700385,0.0),
+       };
+    constexpr inline face_3d scorpion_lod_2_faces[] = {
+        face_3d(scorpion_lod_2_vertices, vertex_3d(0.31458244623206255,-0.933229528269713,-0.17355267813589237),0,1,2,1,1),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(-0.20005368120721428,-0.9386274563242389,-0.2809929231666362),1,3,2,1,2),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(-0.2904250496476645,-0.9054393246435918,0.3095689259698206),4,5,6,1,2),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(-0.22517330753936857,0.9215566730266668,-0.31627563923230345),7,2,3,1,7),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(0.34866306401215547,0.9164161288352303,-0.1965083881270882),2,7,0,1,6),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(0.4398263718022685,-0.892014859979302,0.10422212933613993),8,6,5,1,1),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(-0.19517758407216051,-1.3196430051588238e-06,0.9807679188646075),0,7,1,1,2),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(0.9947807056083444,-1.3729151101938015e-07,0.10203601202195983),1,7,9,5,1,3),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(-0.1249644198820131,-0.17357195102175663,-0.9768606203456319),5,9,8,1,2),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(-0.12228167442075559,0.967365801093252,0.22192475971839512),9,4,6,1,7),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(-0.07730214512392776,-0.6437648292760404,0.7613088879991023),10,11,4,1,2),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(-0.11374893961747405,0.9933274344190212,0.019020693111063518),4,9,7,3,1,5),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(0.005396779500527102,-0.9424439021025558,-0.33432075341015083),5,11,3,1,1,3),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(0.17851127930846028,0.9718904949732937,0.15350110403584427),6,8,9,1,6),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(-0.040644645798802524,0.9887796652397941,-0.14374556123988802),10,4,3,1,6),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(-0.1098557440171888,-0.9148680696873339,-0.38852043778030715),3,11,10,1,4),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(-0.2603310488443559,-0.5777106519104199,0.7736136940856433),4,11,5,1,4),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(0.8289818679492431,-0.5266181930003475,0.1883144747820317),12,0,8,0,2),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(-0.6489693830919947,-0.17555046123946028,-0.7402842530864806),0,12,9,0,1),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(0.1504565043172653,0.9781596662310031,-0.14341027741232917),8,0,9,0,7),
+        face_3d(scorpion_lod_2_vertices, vertex_3d(0.026337034602908108,-0.3819162984072523,0.9238215745582194),8,9,12,0,2),
+    };
+    constexpr inline model_3d_item scorpion_lod_2(scorpion_lod_2_vertices, scorpion_lod_2_faces, scorpion_colors);
+
+    constexpr inline vertex_3d scorpion_lod_1_vertices[] = {
+             vertex_3d(8.13288,0.0507,-4.67061),
+             vertex_3d(-2.38281,-2.07753,-8.55216),
+             vertex_3d(-2.57688,0.0,-16.5909),
+             vertex_3d(-6.961335,-3.116295,-4.296855),
+             vertex_3d(-19.25607,0.0,-4.716105),
+             vertex_3d(-20.761245000000002,0.9665474999999999,2.35806),
+             vertex_3d(-6.961335,-3.11631,4.2968399999999995),
+             vertex_3d(-2.38281,-2.07753,8.55216),
+             vertex_3d(-2.57688,0.0,16.5909),
+             vertex_3d(-6.961335,3.572565,-4.2968399999999995),
+             vertex_3d(-2.38281,2.3817150000000002,-8.55216),
+             vertex_3d(8.13288,0.0507,4.670625),
+             vertex_3d(-8.59758,4.763415,0.0),
+             vertex_3d(-8.59758,-4.155075,0.0),
+             vertex_3d(-5.8308599999999995,1.7862825,2.1484275),
+             vertex_3d(-2.38281,2.3817,8.55216),
+             vertex_3d(-35.935245,0.0,0.0),
+             vertex_3d(-21.877785,-1.687995,0.0),
+             vertex_3d(0.0,-4.700385,0.0),
+             vertex_3d(0.0,0.0,-4.700385),
+             vertex_3d(1.566795,1.566795,1.566795),
+       };
+    constexpr inline face_3d scorpion_lod_1_faces[] = {
+        face_3d(scorpion_lod_1_vertices, vertex_3d(0.27886466796816556,-0.9281293082567249,-0.24659781855056587),0,1,2,1,1),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(-0.22324396452414658,-0.9229510708138261,-0.31356570792603156),3,4,2,1,1,2),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(-0.3084270215715203,-0.7929685236197993,0.5254271528126014),5,6,7,8,1,2),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(-0.014319676384706761,0.9587982613340842,-0.2837267011244708),9,10,2,4,1,7),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(0.3043768489291477,0.9112824911721441,-0.2773426673251956),2,10,0,1,6),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(0.2788643412381228,-0.9281294020789767,0.24659783491010015),11,8,7,1,1),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(-0.34628251526029524,0.0,0.9381302785994083),0,10,1,1,2),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(0.9345344251608998,-7.980569369937069e-07,0.35587274156438237),3,9,12,13,1,3),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(0.8311064558381159,-0.3725671470565155,-0.4128629070265024),6,14,15,7,1,3),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(-0.34628133753705287,0.0,-0.9381307133196044),7,15,11,1,2),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(0.6133239468906396,0.0,-0.7898314606107355),13,12,14,6,1,2),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(-0.05244647314440513,0.9895642842192012,0.134208400826674),14,5,8,15,1,7),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(-0.07730214512392776,-0.6437648292760404,0.7613088879991023),16,17,5,1,2),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(0.680780276384334,-0.0,0.7324876895116189),1,10,9,3,1,4),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(-0.3414045491044495,0.8642303717002582,-0.36952509858143734),5,12,9,4,1,5),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(-0.16634459215792158,-0.8954270978235771,-0.41296463425220903),13,17,4,3,1,3),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(-0.019944015283004747,0.572811895605465,0.8194441826672914),5,14,12,1,4),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(0.3043748703643687,0.9112835854086282,0.2773412433365605),8,11,15,1,6),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(-0.040644645798802524,0.9887796652397941,-0.14374556123988802),16,5,4,1,6),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(-0.1098557440171888,-0.9148680696873339,-0.38852043778030715),4,17,16,1,4),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(-0.11731469423956734,-0.6315008791825855,0.766448890733817),5,17,13,6,1,4),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(0.9622504486493763,-0.19245008972987523,-0.19245008972987523),18,19,20,0,2),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(-0.7232095125765672,-0.48834823687547185,-0.48834823687547185),19,18,14,0,1),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(0.009521676746537611,0.9695358357839514,-0.24476437813262225),20,19,14,0,7),
+        face_3d(scorpion_lod_1_vertices, vertex_3d(0.06811986764427455,-0.2579672732731373,0.9637492254482746),20,14,18,0,2),
+    };
+    constexpr inline model_3d_item scorpion_lod_1(scorpion_lod_1_vertices, scorpion_lod_1_faces, scorpion_colors, scorpion_lod_2, 640);
+
     constexpr inline face_3d scorpion_faces_full[] = {
         face_3d(scorpion_vertices, vertex_3d(0.2789,-0.9281,-0.2466),5,9,4,1,1),
         face_3d(scorpion_vertices, vertex_3d(-0.1840,-0.9352,-0.3027),16,14,4,9,1,2),
@@ -80,6 +172,6 @@
         face_3d(scorpion_vertices, vertex_3d(-0.5774,-0.5774,0.5774),22,23,19,0,2),
         face_3d(scorpion_vertices, vertex_3d(0.5774,0.5774,-0.5774),21,20,24,0,5),
     };
-    constexpr inline model_3d_item scorpion_full(scorpion_vertices, scorpion_faces_full, scorpion_colors);
+    constexpr inline model_3d_item scorpion_full(scorpion_vertices, scorpion_faces_full, scorpion_colors, scorpion_lod_1, 320);
     };
 #endif // FR_MODEL_3D_ITEMS_SCORPION_H
\ No newline at end of file
@@ -13,7 +13,10 @@
 #include "player_ship.h"
 #include "hud_manager.h"
 #include "pause_manager.h"
+#include "stage_budget.h"
+#include "stage_event.h"
 #include "stage_section.h"
+#include "stage_section_index.h"
 #include "stage_section_renderer.h"
 #include "game_over_manager.h"
 #include "end_stage_banner.h"
@@ -24,7 +27,7 @@ class base_game_scene // : public fr::scene
   public:
     base_game_scene(const bn::span<const bn::color> &scene_colors,
                       scene_colors_generator::color_mapping_handler *color_mapping, stage_section_list_ptr sections,
-                      size_t sections_count, int initial_position);
+                      size_t sections_count, const bn::span<const stage_event> &stage_events, int initial_position);
 
     void destroy();
 
@@ -99,7 +102,8 @@ class base_game_scene // : public fr::scene
 
   private:
     stage_section_list_ptr _sections;
-    size_t _sections_count;
+    bn::span<const stage_event> _stage_events;
+    stage_section_index _section_index;
 
     controller _controller;
     fr::camera_3d _camera;
@@ -114,9 +118,11 @@ class base_game_scene // : public fr::scene
     dialog_manager _dialog_manager;
 
     bn::span<const fr::model_3d_item> _model_items; // <-- CAN BEW REMOVED NOW?
+    // Models of the active sections, retained until they change, followed by the ones rendered each frame:
     const fr::model_3d_item *_static_model_items[fr::constants_3d::max_static_models];
+    int _stage_static_count = 0;
 
-    static constexpr int MAX_STATIC_COLLIDERS = 16;
+    static constexpr int MAX_STATIC_COLLIDERS = max_stage_static_colliders;
     sphere_collider _static_colliders[MAX_STATIC_COLLIDERS] = {};
     int _static_collider_count = 0;
     bn::array<sphere_collider_debugger, MAX_STATIC_COLLIDERS> _static_collider_debuggers;
@@ -36,7 +36,7 @@ private:
     static constexpr int TAKE_2_START_TIME = 360;
 
     fr::camera_3d _camera;
-    fr::models_3d _models;
+    fr::models_3d _models{24}; // Only the player ship is drawn
     fr::model_3d *_model = nullptr;
     bn::optional<bn::regular_bg_ptr> _floor_bg;
     bn::optional<bn::affine_bg_ptr> _earth_bg;
@@ -33,7 +33,7 @@ class title_scene : public fr::scene
     hyperlight_background _hyperlight_bg{bn::fixed_point(-1, -1), 4};  // Speed + trail length
 
     fr::camera_3d _camera;
-    fr::models_3d _models;
+    fr::models_3d _models{24}; // Only the player ship is drawn
 
     fr::model_3d *_model;
     int _leave_scene_frame_counter = 0;
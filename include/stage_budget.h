@@ -0,0 +1,116 @@
+#ifndef STAGE_BUDGET_H
+#define STAGE_BUDGET_H
+
+#include "bn_common.h"
+
+#include "fr_constants_3d.h"
+#include "fr_model_3d_item.h"
+
+#include "enemy_type.h"
+#include "stage_section.h"
+#include "stage_section_index.h"
+
+#include "models/asteroid1.h"
+#include "models/moon_oyster.h"
+#include "models/player_ship_02.h"
+#include "models/scorpion.h"
+
+// Max static colliders collected from the active sections:
+constexpr int max_stage_static_colliders = 16;
+
+// Model created by the enemy manager for the given enemy type, or nullptr if
+// the type is not spawned:
+[[nodiscard]] constexpr const fr::model_3d_item *enemy_model_item(
+    enemy_type type)
+{
+    switch (type)
+    {
+    case enemy_type::ASTEROID:
+        return &fr::model_3d_items::asteroid1_full;
+    case enemy_type::OYSTER:
+        return &fr::model_3d_items::moon_oyster_full;
+    case enemy_type::SCORPION:
+        return &fr::model_3d_items::scorpion_full;
+    default:
+        return nullptr;
+    }
+}
+
+// Worst-case load of a stage while the camera is in [end, start): the static
+// models of the active sections and all their enemies are alive and inside
+// the frustum at full detail. Faces are counted before backface culling.
+//
+// Enemy bullets and the static models added each frame (laser, debug
+// colliders) are not counted.
+struct stage_band_budget
+{
+    int start;
+    int end;
+    int sections = 0;
+    int static_models = 0;
+    int static_colliders = 0;
+    int dynamic_models = 1; // Player ship
+    int vertices = fr::model_3d_items::player_ship_02_full.vertices().size();
+    int faces = fr::model_3d_items::player_ship_02_full.faces().size();
+
+    constexpr stage_band_budget(stage_section_list_ptr stage_sections,
+                                size_t stage_sections_count, int band_start,
+                                int band_end)
+        : start(band_start), end(band_end)
+    {
+        for (size_t section_iter = 0; section_iter < stage_sections_count;
+             section_iter++)
+        {
+            const stage_section *section = stage_sections[section_iter];
+
+            if (section->starting_pos() < start || section->ending_pos() > end)
+            {
+                continue;
+            }
+
+            ++sections;
+            static_models += section->static_model_count();
+            static_colliders += section->static_collider_count();
+
+            for (int index = 0; index < section->static_model_count(); ++index)
+            {
+                const fr::model_3d_item &item =
+                    section->static_model_items()[index];
+                vertices += item.vertices().size();
+                faces += item.faces().size();
+            }
+
+            for (int index = 0; index < section->enemies_count(); ++index)
+            {
+                if (const fr::model_3d_item *item =
+                        enemy_model_item(section->enemies()[index].type))
+                {
+                    ++dynamic_models;
+                    vertices += item->vertices().size();
+                    faces += item->faces().size();
+                }
+            }
+        }
+    }
+};
+
+// Checks each limit of the given stage_band_budget with its own static_assert,
+// so a failed build shows the value over the limit. band is a string literal
+// which names the band in the error message:
+#define STAGE_BAND_BUDGET_CHECK(budget, band)                                  \
+    static_assert((budget).sections <=                                         \
+                      stage_section_index::max_active_sections,                \
+                  band " has too many active sections");                       \
+    static_assert((budget).static_models <=                                    \
+                      fr::constants_3d::max_static_models,                     \
+                  band " has too many static models");                         \
+    static_assert((budget).static_colliders <= max_stage_static_colliders,     \
+                  band " has too many static colliders");                      \
+    static_assert((budget).dynamic_models <=                                   \
+                      fr::constants_3d::max_dynamic_models,                    \
+                  band " has too many dynamic models");                        \
+    static_assert((budget).vertices <= FR_MAX_VERTICES,                        \
+                  band " has too many vertices");                              \
+    static_assert((budget).faces <= FR_MAX_FACES, band " has too many faces")
+
+#endif
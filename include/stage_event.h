@@ -0,0 +1,22 @@
+#ifndef STAGE_EVENT_H
+#define STAGE_EVENT_H
+
+#include "bn_common.h"
+
+enum class stage_event_type
+{
+    DESPAWN,
+    SPAWN,
+};
+
+// Section event triggered when the camera reaches the given Y position. The
+// camera moves along -Y, so the events of a stage are sorted by decreasing
+// position (despawns first on ties).
+struct stage_event
+{
+    int position;
+    stage_event_type type;
+    int section_index; // Index of the section in the stage sections list
+};
+
+#endif
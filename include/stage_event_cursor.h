@@ -0,0 +1,27 @@
+#ifndef STAGE_EVENT_CURSOR_H
+#define STAGE_EVENT_CURSOR_H
+
+#include "bn_fixed.h"
+#include "bn_span.h"
+
+#include "stage_event.h"
+#include "stage_section.h"
+
+// Consumes the events of a stage (see stage_event) as the camera reaches them.
+//
+// The camera moves along -Y, so the cursor only advances. Spawns of sections
+// entered and passed between two updates are skipped.
+class stage_event_cursor
+{
+  public:
+    // Returns the next event reached by the camera, or nullptr if there's
+    // none:
+    [[nodiscard]] const stage_event *next(
+        const bn::span<const stage_event> &events,
+        stage_section_list_ptr sections, bn::fixed camera_y);
+
+  private:
+    int _next_event_index = 0;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef STAGE_SECTION_INDEX_H
+#define STAGE_SECTION_INDEX_H
+
+#include "bn_fixed.h"
+#include "bn_span.h"
+#include "bn_vector.h"
+
+#include "stage_section.h"
+
+// Keeps the sections of a stage sorted by their starting and ending
+// positions, so the sections the camera is in are found without testing all
+// of them every frame.
+//
+// The camera moves along -Y, so the cursors usually only advance. Moving
+// backwards rewinds them. Only the sections crossed by the cursors are
+// added to or removed from the active ones.
+//
+// The constructor asserts that the active sections always fit in
+// max_active_sections.
+class stage_section_index
+{
+  public:
+    static constexpr int max_sections = 64;
+    static constexpr int max_active_sections = 8;
+
+    stage_section_index(stage_section_list_ptr sections,
+                        size_t sections_count);
+
+    // Must be called once per frame, before querying the sections. Returns
+    // true if the active sections have changed:
+    bool update(bn::fixed camera_position);
+
+    // Sections with camera_position <= starting_pos() and
+    // camera_position > ending_pos(), sorted by starting position:
+    [[nodiscard]] bn::span<const stage_section *const> active_sections() const
+    {
+        return bn::span<const stage_section *const>(_active_sections.data(),
+                                                    _active_sections.size());
+    }
+
+  private:
+    bn::vector<const stage_section *, max_sections> _sections_by_start;
+    bn::vector<const stage_section *, max_sections> _sections_by_end;
+    bn::vector<const stage_section *, max_active_sections> _active_sections;
+
+    // Sections in [0, _entered_count) of _sections_by_start have been entered,
+    // and sections in [0, _passed_count) of _sections_by_end have been passed:
+    int _entered_count = 0;
+    int _passed_count = 0;
+
+    void _remove_active_section(const stage_section *section);
+
+    void _add_active_section(const stage_section *section,
+                             bn::fixed camera_position);
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include "fr_model_3d_item.h"
 #include "fr_models_3d.h"
 #include "stage_section.h"
+#include "stage_section_index.h"
 #include "colliders.h"
 
 class stage_section_renderer
@@ -14,18 +15,11 @@ class stage_section_renderer
         const stage_section *section, fr::models_3d &models,
         const fr::model_3d_item **static_model_items);
 
-    static int render_sections(const bn::fixed camera_position,
-                               stage_section_list_ptr sections,
-                               size_t sections_count,
+    static int render_sections(const stage_section_index &section_index,
                                const fr::model_3d_item **static_model_items);
 
-    static int manage_section_render(
-        stage_section_list_ptr sections, size_t sections_count,
-        fr::camera_3d &camera, const fr::model_3d_item **static_model_items);
-
     static int collect_section_colliders(
-        stage_section_list_ptr sections, size_t sections_count,
-        bn::fixed camera_position,
+        const stage_section_index &section_index,
         sphere_collider *out_colliders, int max_colliders);
 };
 
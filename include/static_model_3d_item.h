@@ -2,12 +2,53 @@
 #ifndef STATIC_MODEL_3D_ITEM_H
 #define STATIC_MODEL_3D_ITEM_H
 
+#include "bn_array.h"
 #include "bn_color.h"
 #include "bn_span.h"
+#include "bn_type_traits.h"
 
 #include "fr_model_3d.h"
 #include "fr_point_3d.h"
 
+template <const fr::model_3d_item &model_3d_item_ref> class static_model_3d_item;
+
+// Bakes the lower detail levels of a static_model_3d_item with the same
+// position, rotation and palette.
+template <const fr::model_3d_item *model_3d_item_ptr>
+class static_model_3d_item_lower_detail
+{
+  public:
+    constexpr static_model_3d_item_lower_detail(fr::point_3d position,
+                                                bn::fixed theta,
+                                                const bn::color *palette)
+        : _model(position, theta, palette), _item(_model.item())
+    {
+    }
+
+    [[nodiscard]] constexpr const fr::model_3d_item *item() const
+    {
+        return &_item;
+    }
+
+  private:
+    static_model_3d_item<*model_3d_item_ptr> _model;
+    fr::model_3d_item _item;
+};
+
+template <> class static_model_3d_item_lower_detail<nullptr>
+{
+  public:
+    constexpr static_model_3d_item_lower_detail(fr::point_3d, bn::fixed,
+                                                const bn::color *)
+    {
+    }
+
+    [[nodiscard]] constexpr const fr::model_3d_item *item() const
+    {
+        return nullptr;
+    }
+};
+
 template <const fr::model_3d_item &model_3d_item_ref> class static_model_3d_item
 {
   public:
@@ -21,7 +62,7 @@ template <const fr::model_3d_item &model_3d_item_ref> class static_model_3d_item
               model_3d_item_ref.vertices()[0])),
           _faces(_create_array<fr::face_3d, faces_count>(
               model_3d_item_ref.faces()[0])),
-          _palette(palette)
+          _palette(palette), _lower_detail(position, theta, palette)
     {
         const bn::span<const fr::vertex_3d> &input_vertices =
             model_3d_item_ref.vertices();
@@ -84,25 +125,84 @@ template <const fr::model_3d_item &model_3d_item_ref> class static_model_3d_item
                     input_face.shading());
             }
         }
+
+        if constexpr (clusters_count > 0)
+        {
+            _face_clusters = fr::face_clusters_3d_array<clusters_count>(
+                _faces, model_3d_item_ref.face_clusters());
+        }
+
+        if constexpr (packed)
+        {
+            _packed_faces.array =
+                fr::packed_faces_3d_array<faces_count>(_faces);
+            _packed_faces.faces = fr::packed_faces_3d(_packed_faces.array);
+        }
     }
 
     [[nodiscard]] constexpr fr::model_3d_item item() const
     {
         const bn::color *color_palette =
             !!_palette ? _palette : model_3d_item_ref.palette();
+        const fr::packed_faces_3d *packed_faces = nullptr;
+
+        bn::span<const fr::face_cluster_3d> face_clusters;
+
+        if constexpr (packed)
+        {
+            packed_faces = &_packed_faces.faces;
+        }
+
+        if constexpr (clusters_count > 0)
+        {
+            face_clusters = _face_clusters.clusters();
+        }
+
         return fr::model_3d_item(_vertices, _faces,
                                  model_3d_item_ref.collision_face(),
-                                 &_vertical_cylinder, color_palette);
+                                 &_vertical_cylinder, color_palette,
+                                 _lower_detail.item(),
+                                 model_3d_item_ref.lower_detail_distance(),
+                                 packed_faces, face_clusters);
     }
 
   private:
     static constexpr int vertices_count = model_3d_item_ref.vertices().size();
     static constexpr int faces_count = model_3d_item_ref.faces().size();
 
+    // Packed faces are only baked if the input model has them:
+    static constexpr bool packed = model_3d_item_ref.packed_faces() != nullptr;
+
+    struct packed_faces_storage
+    {
+        fr::packed_faces_3d_array<faces_count> array;
+        fr::packed_faces_3d faces;
+    };
+
+    struct no_packed_faces_storage
+    {
+    };
+
+    // Face clusters are recalculated from the rotated faces:
+    static constexpr int clusters_count =
+        model_3d_item_ref.face_clusters().size();
+
+    struct no_face_clusters_storage
+    {
+    };
+
     bn::array<fr::vertex_3d, vertices_count> _vertices;
     bn::array<fr::face_3d, faces_count> _faces;
+    bn::conditional_t<packed, packed_faces_storage, no_packed_faces_storage>
+        _packed_faces;
+    bn::conditional_t<(clusters_count > 0),
+                      fr::face_clusters_3d_array<clusters_count>,
+                      no_face_clusters_storage>
+        _face_clusters;
     fr::model_3d_vertical_cylinder _vertical_cylinder;
     const bn::color *_palette;
+    static_model_3d_item_lower_detail<model_3d_item_ref.lower_detail()>
+        _lower_detail;
 
     template <typename Type, unsigned Size>
     [[nodiscard]] static constexpr bn::array<Type, Size> _create_array(
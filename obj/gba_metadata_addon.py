@@ -10,6 +10,7 @@ bl_info = {
 
 import bpy
 import bmesh
+import os
 
 class MESH_PT_face_attribute_setter(bpy.types.Panel):
     bl_label = "GBA Model Metadata Helper"
@@ -336,8 +337,15 @@ class MESH_OT_export_with_metadata(bpy.types.Operator):
             self.report({'ERROR'}, "OBJ export failed: " + "; ".join(export_errors) if export_errors else "Unknown exporter issue")
             return {'CANCELLED'}
 
-        # Gather metadata
+        # Gather metadata (keeping keys not handled here, like engine_lods)
+        import json
         metadata = {}
+        if os.path.exists(json_path):
+            try:
+                with open(json_path, 'r', encoding='utf-8') as jf:
+                    metadata = json.load(jf)
+            except Exception:
+                metadata = {}
         metadata['engine_scale'] = int(obj.get('engine_scale', 10))
         brightness = []
         if obj.mode == 'EDIT':
@@ -356,7 +364,6 @@ class MESH_OT_export_with_metadata(bpy.types.Operator):
             bm.free()
         metadata['engine_brightness'] = brightness
 
-        import json
         try:
             with open(json_path, 'w', encoding='utf-8') as jf:
                 json.dump(metadata, jf, indent=2)
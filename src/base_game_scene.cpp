@@ -7,8 +7,10 @@
 
 base_game_scene::base_game_scene(const bn::span<const bn::color> &scene_colors,
                                      scene_colors_generator::color_mapping_handler *color_mapping,
-                                     stage_section_list_ptr sections, size_t sections_count, int initial_position)
-        : _sections(sections), _sections_count(sections_count), _player_ship(this),
+                                     stage_section_list_ptr sections, size_t sections_count,
+                                     const bn::span<const stage_event> &stage_events, int initial_position)
+        : _sections(sections), _stage_events(stage_events), _section_index(sections, sections_count),
+            _player_ship(this),
             _enemy_manager(this), _hud_manager(this), _pause_manager(this),
             _game_over_manager(this), _end_stage_banner(this), _prepare_to_leave(false)
 {
@@ -18,6 +20,9 @@ base_game_scene::base_game_scene(const bn::span<const bn::color> &scene_colors,
     // Load 3D model colors.
     _models.load_colors(scene_colors, color_mapping);
 
+    // Stage models are added when entering the first section.
+    _models.set_retained_static_model_items(_static_model_items, 0);
+
     _score = 0;
     _next_scene_override = bn::nullopt;
 }
@@ -35,6 +40,7 @@ bool base_game_scene::update()
     if (_game_over_manager.is_shown())
     {
         _game_over_manager.menu_update();
+        _models.retain_last_frame();
         return false;
     }
 
@@ -46,6 +52,7 @@ bool base_game_scene::update()
         {
             destroy();
         }
+        _models.retain_last_frame();
         return false;
     }
 
@@ -55,6 +62,7 @@ bool base_game_scene::update()
         _dialog_manager.suspend_for_pause();
         // Is paused, only update pause menu.
         _pause_manager.menu_update();
+        _models.retain_last_frame();
         return false;
     }
 
@@ -63,6 +71,7 @@ bool base_game_scene::update()
     if (_hit_stop_cooldown > 0)
     {
         _hit_stop_cooldown--;
+        _models.retain_last_frame();
         return false;
     }
     
@@ -74,18 +83,24 @@ bool base_game_scene::update()
         // - Player
         _player_ship.update();
 
+        // - Sections (stage models and colliders only change with the active sections)
+        if (_section_index.update(_camera.position().y()))
+        {
+            _stage_static_count =
+                stage_section_renderer::render_sections(_section_index, _static_model_items);
+            _models.set_retained_static_model_items(_static_model_items, _stage_static_count);
+
+            _static_collider_count =
+                stage_section_renderer::collect_section_colliders(
+                    _section_index, _static_colliders, MAX_STATIC_COLLIDERS);
+        }
+
         // - Enemies
-        _enemy_manager.process_section_enemies(_sections, _sections_count, _camera.position().y());
+        _enemy_manager.process_section_enemies(_stage_events, _sections, _camera.position().y());
         _enemy_manager.update();
 
         // - Collisions
-        static_count =
-            stage_section_renderer::manage_section_render(_sections, _sections_count, _camera, _static_model_items);
-
-        _static_collider_count =
-            stage_section_renderer::collect_section_colliders(
-                _sections, _sections_count, _camera.position().y(),
-                _static_colliders, MAX_STATIC_COLLIDERS);
+        static_count = _stage_static_count;
 
         _player_ship.collision_update(_static_model_items, static_count,
                                       _static_colliders, _static_collider_count,
@@ -99,7 +114,7 @@ bool base_game_scene::update()
         static_count = _enemy_manager.statics_render(_static_model_items, static_count);
 
         // - Final models update
-        _models.set_static_model_items(_static_model_items, static_count);
+        _models.set_transient_static_models_count(static_count - _stage_static_count);
         _models.update(_camera);
         _hud_manager.statics_update(static_count);
     }
@@ -148,6 +163,7 @@ int base_game_scene::debug_render_static_colliders(
             dbg.debug_vertices, fr::vertex_3d(0, 1, 0), 2, 1, 0, 0, 7);
         dbg.debug_faces[1].reset(
             dbg.debug_vertices, fr::vertex_3d(0, 1, 0), 0, 3, 2, 0, 7);
+        dbg.debug_model.update_bounding_sphere();
 
         if (static_count < fr::constants_3d::max_static_models)
         {
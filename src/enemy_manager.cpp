@@ -33,6 +33,7 @@ void enemy_manager::destroy()
             _enemies[i].used = false;
             _enemies[i].ptr = nullptr;
             _enemies[i].source = nullptr;
+            _enemies[i].section_index = -1;
         }
     }
 }
@@ -51,6 +52,7 @@ void enemy_manager::update()
                 _enemies[i].ptr = nullptr;
                 _enemies[i].used = false;
                 _enemies[i].source = nullptr;
+                _enemies[i].section_index = -1;
                 // Check if ready to finish stage.
                 if (is_end_section_current)
                 {
@@ -74,91 +76,23 @@ int enemy_manager::statics_render(const fr::model_3d_item **static_model_items,
     return current;
 }
 
-void enemy_manager::process_section_enemies(stage_section_list_ptr sections, size_t sections_count, bn::fixed camera_y)
+void enemy_manager::process_section_enemies(const bn::span<const stage_event> &events,
+                                            stage_section_list_ptr sections, bn::fixed camera_y)
 {
-    bn::fixed latest_section_end_y = _last_section_end_y;
-
-    for (size_t i = 0; i < sections_count; ++i)
+    // Consume the events reached by the camera
+    while (const stage_event *event = _event_cursor.next(events, sections, camera_y))
     {
-        const stage_section *section = sections[i];
+        const stage_section *section = sections[event->section_index];
 
-        // Instantiate enemies when entering a new section
-        if (camera_y <= section->starting_pos() && camera_y > section->ending_pos() &&
-            section->starting_pos() < _last_section_start_y)
+        if (event->type == stage_event_type::SPAWN)
         {
-            // Instantiate enemies in this section
-            _last_section_start_y = section->starting_pos();
-
-            BN_LOG("[section] Entering section at start=" + bn::to_string<64>(section->starting_pos()) +
-                   " enemies=" + bn::to_string<64>(section->enemies_count()));
-
-            for (int e = 0; e < section->enemies_count(); ++e)
-            {
-                const enemy_def &enemy = section->enemies()[e];
-                BN_LOG("[enemy] type=" + bn::to_string<64>(static_cast<int>(enemy.type)));
-                // <-- Make switch case
-                if (enemy.type == enemy_type::ASTEROID)
-                {
-                    spawn_asteroid(enemy);
-                }
-                else if (enemy.type == enemy_type::OYSTER)
-                {
-                    spawn_oyster(enemy);
-                }
-                else if (enemy.type == enemy_type::SCORPION)
-                {
-                    spawn_scorpion(enemy);
-                }
-            }
-
-            //  Check if this is the end section
-            if (section->is_end_section())
-            {
-                is_end_section_current = true;
-            }
+            spawn_section_enemies(section, event->section_index);
         }
-
-        // Deinstantiate enemies from sections that the camera has passed
-        // Only destroy if: camera passed the end AND we haven't destroyed this section yet
-        if (camera_y <= section->ending_pos() && section->ending_pos() < _last_section_end_y)
+        else
         {
-            // This section needs cleanup - destroy its enemies
-            for (int slot = 0; slot < MAX_ENEMIES; ++slot)
-            {
-                if (_enemies[slot].used && _enemies[slot].ptr && _enemies[slot].source)
-                {
-                    // Check if this enemy belongs to the current section by comparing its descriptor
-                    // against all enemies in this section
-                    for (int e = 0; e < section->enemies_count(); ++e)
-                    {
-                        if (_enemies[slot].source == &section->enemies()[e])
-                        {
-                            // This enemy belongs to this section, destroy it
-                            _enemies[slot].ptr->destroy();
-                            delete _enemies[slot].ptr;
-                            _enemies[slot].ptr = nullptr;
-                            _enemies[slot].used = false;
-                            _enemies[slot].source = nullptr;
-                            BN_LOG("[destroy] Section enemy destroyed at ending_pos=" + bn::to_string<64>(section->ending_pos()));
-                            // Check if ready to finish stage.
-                            if (is_end_section_current)
-                            {
-                                check_end_section_cleaned();
-                            }
-                            break;
-                        }
-                    }
-                }
-            }
-
-            // <-- How about enemies already destroyed?
-
-            // Update the tracker to this section's ending pos
-            latest_section_end_y = section->ending_pos();
+            destroy_section_enemies(section, event->section_index);
         }
     }
-    // Updates at the end to make sure all sections are processed first
-    _last_section_end_y = latest_section_end_y;
 
     // Clean up refless objects such as bullets
     for (int slot = 0; slot < MAX_ENEMIES; ++slot)
@@ -185,6 +119,63 @@ void enemy_manager::process_section_enemies(stage_section_list_ptr sections, siz
     }
 }
 
+void enemy_manager::spawn_section_enemies(const stage_section *section, int section_index)
+{
+    // Instantiate enemies when entering a new section
+    BN_LOG("[section] Entering section at start=" + bn::to_string<64>(section->starting_pos()) +
+           " enemies=" + bn::to_string<64>(section->enemies_count()));
+
+    for (int e = 0; e < section->enemies_count(); ++e)
+    {
+        const enemy_def &enemy = section->enemies()[e];
+        BN_LOG("[enemy] type=" + bn::to_string<64>(static_cast<int>(enemy.type)));
+        // <-- Make switch case
+        if (enemy.type == enemy_type::ASTEROID)
+        {
+            spawn_asteroid(enemy, section_index);
+        }
+        else if (enemy.type == enemy_type::OYSTER)
+        {
+            spawn_oyster(enemy, section_index);
+        }
+        else if (enemy.type == enemy_type::SCORPION)
+        {
+            spawn_scorpion(enemy, section_index);
+        }
+    }
+
+    //  Check if this is the end section
+    if (section->is_end_section())
+    {
+        is_end_section_current = true;
+    }
+}
+
+void enemy_manager::destroy_section_enemies(const stage_section *section, int section_index)
+{
+    // Deinstantiate enemies owned by the section that the camera has passed
+    for (int slot = 0; slot < MAX_ENEMIES; ++slot)
+    {
+        if (_enemies[slot].used && _enemies[slot].ptr && _enemies[slot].section_index == section_index)
+        {
+            _enemies[slot].ptr->destroy();
+            delete _enemies[slot].ptr;
+            _enemies[slot].ptr = nullptr;
+            _enemies[slot].used = false;
+            _enemies[slot].source = nullptr;
+            _enemies[slot].section_index = -1;
+            BN_LOG("[destroy] Section enemy destroyed at ending_pos=" + bn::to_string<64>(section->ending_pos()));
+            // Check if ready to finish stage.
+            if (is_end_section_current)
+            {
+                check_end_section_cleaned();
+            }
+        }
+    }
+
+    // <-- How about enemies already destroyed?
+}
+
 void enemy_manager::create_bullet(fr::point_3d position, fr::point_3d target)
 {
     // <-- Separate this into its own method
@@ -204,7 +195,7 @@ void enemy_manager::create_bullet(fr::point_3d position, fr::point_3d target)
     }
 }
 
-void enemy_manager::spawn_asteroid(const enemy_def &enemy)
+void enemy_manager::spawn_asteroid(const enemy_def &enemy, int section_index)
 {
     for (int slot = 0; slot < MAX_ENEMIES; ++slot)
     {
@@ -221,6 +212,7 @@ void enemy_manager::spawn_asteroid(const enemy_def &enemy)
             _enemies[slot].ptr = new asteroid(enemy.position, movement, _models, _controller, _base_scene); // <-- Convert to a proper object pool later
             _enemies[slot].used = true;
             _enemies[slot].source = &enemy;
+            _enemies[slot].section_index = section_index;
             BN_LOG("[spawn] ASTEROID: y DEPTH=" + bn::to_string<64>(int(enemy.position.y())) +
                    " x=" + bn::to_string<64>(int(enemy.position.x())) +
                    " z=" + bn::to_string<64>(int(enemy.position.z())));
@@ -229,7 +221,7 @@ void enemy_manager::spawn_asteroid(const enemy_def &enemy)
     }
 }
 
-void enemy_manager::spawn_oyster(const enemy_def &enemy)
+void enemy_manager::spawn_oyster(const enemy_def &enemy, int section_index)
 {
     for (int slot = 0; slot < MAX_ENEMIES; ++slot)
     {
@@ -248,6 +240,7 @@ void enemy_manager::spawn_oyster(const enemy_def &enemy)
             _enemies[slot].ptr = new oyster(enemy.position, movement, _models, _controller, this, _base_scene, props); // <-- Convert to a proper object pool later
             _enemies[slot].used = true;
             _enemies[slot].source = &enemy;
+            _enemies[slot].section_index = section_index;
             BN_LOG("[spawn] OYSTER: y DEPTH=" + bn::to_string<64>(int(enemy.position.y())) +
                    " x=" + bn::to_string<64>(int(enemy.position.x())) +
                    " z=" + bn::to_string<64>(int(enemy.position.z())));
@@ -256,7 +249,7 @@ void enemy_manager::spawn_oyster(const enemy_def &enemy)
     }
 }
 
-void enemy_manager::spawn_scorpion(const enemy_def &enemy)
+void enemy_manager::spawn_scorpion(const enemy_def &enemy, int section_index)
 {
     for (int slot = 0; slot < MAX_ENEMIES; ++slot)
     {
@@ -272,6 +265,7 @@ void enemy_manager::spawn_scorpion(const enemy_def &enemy)
             _enemies[slot].ptr = new scorpion(enemy.position, _models, _controller, this, _base_scene, props);
             _enemies[slot].used = true;
             _enemies[slot].source = &enemy;
+            _enemies[slot].section_index = section_index;
             BN_LOG("[spawn] SCORPION: y DEPTH=" + bn::to_string<64>(int(enemy.position.y())) +
                    " x=" + bn::to_string<64>(int(enemy.position.x())) +
                    " z=" + bn::to_string<64>(int(enemy.position.z())));
@@ -6,10 +6,15 @@
 #include "fr_models_3d.h"
 
 #include "../../../butano/butano/hw/include/bn_hw_sprites.h"
+#include "bn_memory.h"
 #include "bn_profiler.h"
+#include "bn_timer.h"
+#include "bn_utility.h"
 
 #include "fr_camera_3d.h"
+#include "fr_depth_sort.h"
 #include "fr_div_lut.h"
+#include "fr_face_cluster_visibility.h"
 #include "fr_sprite_3d_item.h"
 
 #if FR_DETAILED_PROFILE
@@ -27,6 +32,29 @@
     } while (false)
 #endif
 
+// The render governor adds up the ticks of the most expensive sections:
+#if FR_RENDER_GOVERNOR
+#define FR_GOVERNOR_START() governor_timer.restart()
+#define FR_GOVERNOR_STOP() _render_ticks += governor_timer.elapsed_ticks()
+#else
+#define FR_GOVERNOR_START()                                                    \
+    do                                                                         \
+    {                                                                          \
+    } while (false)
+
+#define FR_GOVERNOR_STOP()                                                     \
+    do                                                                         \
+    {                                                                          \
+    } while (false)
+#endif
+
+#if FR_ARM_PROJECTION
+// Defined in fr_project_vertices.s:
+extern "C" int fr_project_vertices(const fr::vertex_3d *vertices,
+                                   int vertices_count, void *projected_vertices,
+                                   const void *params);
+#endif
+
 namespace fr
 {
 
@@ -34,19 +62,149 @@ namespace
 {
 constexpr int fixed_precision = 18;
 using fixed = bn::fixed_t<fixed_precision>;
+
+// Per face data of both faces layouts, so the per-face loops are instantiated
+// once per layout:
+class faces_reader
+{
+
+  public:
+    explicit faces_reader(const face_3d *faces) : _faces(faces)
+    {
+    }
+
+    [[nodiscard]] const point_3d &centroid(int index) const
+    {
+        return _faces[index].centroid().point();
+    }
+
+    [[nodiscard]] const vertex_3d &centroid_vertex(int index) const
+    {
+        return _faces[index].centroid();
+    }
+
+    [[nodiscard]] const point_3d &normal(int index) const
+    {
+        return _faces[index].normal().point();
+    }
+
+    [[nodiscard]] const vertex_3d &normal_vertex(int index) const
+    {
+        return _faces[index].normal();
+    }
+
+    [[nodiscard]] const face_indexes_3d &indexes(int index) const
+    {
+        return _faces[index].indexes();
+    }
+
+    [[nodiscard]] int color_index(int index) const
+    {
+        return _faces[index].color_index();
+    }
+
+    [[nodiscard]] int shading(int index) const
+    {
+        return _faces[index].shading();
+    }
+
+    [[nodiscard]] bool triangle(int index) const
+    {
+        return _faces[index].triangle();
+    }
+
+  private:
+    const face_3d *_faces;
+};
+
+class packed_faces_reader
+{
+
+  public:
+    explicit packed_faces_reader(const packed_faces_3d &faces)
+        : _faces(faces)
+    {
+    }
+
+    [[nodiscard]] const point_3d &centroid(int index) const
+    {
+        return _faces.centroids()[index];
+    }
+
+    [[nodiscard]] vertex_3d centroid_vertex(int index) const
+    {
+        return vertex_3d(_faces.centroids()[index]);
+    }
+
+    [[nodiscard]] point_3d normal(int index) const
+    {
+        return _faces.normals()[index].point();
+    }
+
+    [[nodiscard]] vertex_3d normal_vertex(int index) const
+    {
+        return vertex_3d(normal(index));
+    }
+
+    [[nodiscard]] const face_indexes_3d &indexes(int index) const
+    {
+        return _faces.indexes()[index];
+    }
+
+    [[nodiscard]] int color_index(int index) const
+    {
+        return _faces.materials()[index].color_index();
+    }
+
+    [[nodiscard]] int shading(int index) const
+    {
+        return _faces.materials()[index].shading();
+    }
+
+    [[nodiscard]] bool triangle(int index) const
+    {
+        return _faces.materials()[index].triangle();
+    }
+
+  private:
+    const packed_faces_3d &_faces;
+};
+
+// Returns the lowest detail level of the given item which can be used at the
+// given camera depth (with 8 fractional bits):
+[[nodiscard]] const model_3d_item *select_detail(
+    const model_3d_item *model_item, int depth)
+{
+    while (const model_3d_item *lower_detail = model_item->lower_detail())
+    {
+        if (depth < (model_item->lower_detail_distance() << 8))
+        {
+            break;
+        }
+
+        model_item = lower_detail;
+    }
+
+    return model_item;
+}
 } // namespace
 
+// Globals are placed in IWRAM by default:
+models_3d::render_arena models_3d::_render_arena;
+
 void models_3d::_process_models(const camera_3d &camera)
 {
     constexpr int display_width = bn::display::width();
     constexpr int display_height = bn::display::height();
     constexpr int focal_length_shift = constants_3d::focal_length_shift;
-    constexpr int near_plane = 24 * 256 * 16;
+    constexpr int near_plane = vertex_projection::near_plane;
+
+    // Projected x of merged models vertices behind the near plane:
+    constexpr int16_t behind_vertex_x = -32768;
 
-    point_2d _projected_vertices[_max_vertices];
-    valid_face_info _valid_faces_info[_max_faces];
-    int _visible_face_projected_zs[_max_faces];
-    uint8_t _visible_face_indexes[_max_faces];
+    point_2d *_projected_vertices = _render_arena.projected_vertices;
+    valid_face_info *_valid_faces_info = _render_arena.valid_faces_info;
+    uint16_t *_visible_face_depth_keys = _render_arena.visible_face_depth_keys;
 
     point_3d camera_position = camera.position();
     bn::fixed camera_phi = camera.phi();
@@ -61,99 +219,392 @@ void models_3d::_process_models(const camera_3d &camera)
     bn::fixed camera_w_z = camera.w().z();
     int global_vertex_index = 0;
     int valid_faces_count = 0;
+    int dropped_faces_count = 0;
+    int lod_depth_scale = _render_governor.lod_depth_scale();
+    int far_depth = _render_governor.far_depth();
+    int max_sprites = _render_governor.max_sprites();
+
+#if FR_RENDER_GOVERNOR
+    bn::timer governor_timer;
+    _render_ticks = 0;
+#endif
+
+#if FR_ARM_PROJECTION
+    static_assert(focal_length_shift == 8 && near_plane == 0x18000 &&
+                      display_width == 240 && display_height == 160,
+                  "fr_project_vertices.s constants must be updated");
+#endif
+
+    vertex_projection::params projection = {
+        camera_position.x().data(), camera_position.y().data(),
+        camera_position.z().data(), camera_u_x.data(),
+        camera_u_y.data(),          camera_u_z.data(),
+        camera_v_x.data(),          camera_v_y.data(),
+        camera_v_z.data(),          camera_w_x.data(),
+        camera_w_y.data(),          camera_w_z.data(),
+        div_lut_ptr};
+
+    // Once the valid faces are full, their indexes are kept in a max-heap by
+    // projected z, so the farthest one can be replaced without scanning all of
+    // them. The heap reuses the radix sort temporaries, which aren't needed
+    // until visible faces are sorted:
+    face_index_type *farthest_valid_faces = _render_arena.temp_visible_face_indexes;
+    bool farthest_valid_faces_ready = false;
+
+    auto sift_down_farthest_valid_face = [&](int heap_index) {
+        face_index_type face_index = farthest_valid_faces[heap_index];
+        int projected_z = _valid_faces_info[face_index].projected_z;
+
+        while (true)
+        {
+            int child_index = (heap_index * 2) + 1;
+
+            if (child_index >= _max_faces)
+            {
+                break;
+            }
+
+            if (child_index + 1 < _max_faces &&
+                _valid_faces_info[farthest_valid_faces[child_index + 1]].projected_z >
+                    _valid_faces_info[farthest_valid_faces[child_index]].projected_z)
+            {
+                ++child_index;
+            }
+
+            face_index_type child_face_index = farthest_valid_faces[child_index];
+
+            if (_valid_faces_info[child_face_index].projected_z <= projected_z)
+            {
+                break;
+            }
+
+            farthest_valid_faces[heap_index] = child_face_index;
+            heap_index = child_index;
+        }
+
+        farthest_valid_faces[heap_index] = face_index;
+    };
+
+    // Stores the given valid face. If there's no space left, the farthest
+    // valid face is dropped instead:
+    auto add_valid_face = [&](const valid_face_info &valid_face) {
+        if (valid_faces_count < _max_faces) [[likely]]
+        {
+            _valid_faces_info[valid_faces_count] = valid_face;
+            ++valid_faces_count;
+            return;
+        }
+
+        ++dropped_faces_count;
+
+        if (!farthest_valid_faces_ready)
+        {
+            for (int index = 0; index < _max_faces; ++index)
+            {
+                farthest_valid_faces[index] = face_index_type(index);
+            }
+
+            for (int index = (_max_faces / 2) - 1; index >= 0; --index)
+            {
+                sift_down_farthest_valid_face(index);
+            }
+
+            farthest_valid_faces_ready = true;
+        }
+
+        valid_face_info &farthest_valid_face =
+            _valid_faces_info[farthest_valid_faces[0]];
+
+        if (valid_face.projected_z < farthest_valid_face.projected_z)
+        {
+            farthest_valid_face = valid_face;
+            sift_down_farthest_valid_face(0);
+        }
+    };
+
+    // Returns false if the given sphere is fully behind the near plane, fully
+    // beyond the far depth or fully outside one of the side frustum planes.
+    // Otherwise, stores the depth of its center in depth:
+    auto sphere_in_frustum = [&](const point_3d &center, int integer_radius,
+                                 int &depth) {
+        // Bit shifting to avoid overflow
+        bn::fixed vrx = bn::fixed::from_data((center.x() - camera_position.x()).data() >> 4);
+        bn::fixed vry = bn::fixed::from_data((center.y() - camera_position.y()).data() >> 4);
+        bn::fixed vrz = bn::fixed::from_data((center.z() - camera_position.z()).data() >> 4);
+
+        // No <<4 here, so vcz has the same precision as vcx and vcy:
+        int vcz = -(vrx.unsafe_multiplication(camera_w_x) +
+                    vry.unsafe_multiplication(camera_w_y) +
+                    vrz.unsafe_multiplication(camera_w_z)).data();
+        int radius = integer_radius << 8;
+
+        if (vcz + radius < (near_plane >> 4))
+        {
+            return false;
+        }
+
+        if (far_depth && vcz - radius > far_depth) [[unlikely]]
+        {
+            return false;
+        }
+
+        // Projected x is 256 * x / z + 120, so the side planes normals are
+        // (+-256, -120); 283 >= their length:
+        int vcx = (vrx.unsafe_multiplication(camera_u_x) +
+                   vry.unsafe_multiplication(camera_u_y) +
+                   vrz.unsafe_multiplication(camera_u_z))
+                      .data();
+
+        if ((bn::abs(vcx) << 8) - (vcz * (display_width / 2)) > radius * 283)
+        {
+            return false;
+        }
+
+        // Projected y is 256 * y / z + 80, so the top and bottom planes normals
+        // are (+-256, -80); 269 >= their length:
+        int vcy = (vrx.unsafe_multiplication(camera_v_x) +
+                   vry.unsafe_multiplication(camera_v_y) +
+                   vrz.unsafe_multiplication(camera_v_z))
+                      .data();
+
+        if ((bn::abs(vcy) << 8) - (vcz * (display_height / 2)) > radius * 269)
+        {
+            return false;
+        }
+
+        depth = vcz;
+        return true;
+    };
+
+    // Projects the given vertices until one of them is behind the near plane.
+    // Returns the number of projected vertices:
+    auto project_vertices = [](const vertex_3d *vertices, int vertices_count,
+                               point_2d *projected_vertices,
+                               const vertex_projection::params &params) {
+#if FR_ARM_PROJECTION
+        return fr_project_vertices(vertices, vertices_count,
+                                   projected_vertices, &params);
+#else
+        return vertex_projection::project(vertices, vertices_count,
+                                          projected_vertices, params);
+#endif
+    };
 
     // Project static models:
 
     FR_PROFILER_START("static_project");
+    FR_GOVERNOR_START();
 
     for (int static_model_index = _static_models_count - 1;
          static_model_index >= 0; --static_model_index)
     {
         const model_3d_item *model_item =
             _static_model_items_ptr[static_model_index];
+        const model_3d_bounding_sphere &bounding_sphere =
+            model_item->bounding_sphere();
+        int depth;
+
+        if (!sphere_in_frustum(bounding_sphere.center().point(),
+                               bounding_sphere.integer_radius(), depth))
+        {
+            continue;
+        }
+
+        model_item = select_detail(model_item, (depth * lod_depth_scale) >> 4);
+
         const vertex_3d *model_vertices = model_item->vertices().data();
         point_2d *projected_vertices =
             _projected_vertices + global_vertex_index;
         int model_vertices_count = model_item->vertices().size();
-        bool valid_model = true;
-
-        for (int index = 0; index < model_vertices_count; ++index)
+        if (global_vertex_index + model_vertices_count > _max_vertices)
+            [[unlikely]]
         {
-            const point_3d &model_point = model_vertices[index].point();
-
-            // Bit shifting to avoid overflow
-            bn::fixed vrx = bn::fixed::from_data((model_point.x() - camera_position.x()).data() >> 4);
-            bn::fixed vry = bn::fixed::from_data((model_point.y() - camera_position.y()).data() >> 4);
-            bn::fixed vrz = bn::fixed::from_data((model_point.z() - camera_position.z()).data() >> 4);
-            
-            int vcz = -(vrx.unsafe_multiplication(camera_w_x) +
-                        vry.unsafe_multiplication(camera_w_y) +
-                        vrz.unsafe_multiplication(camera_w_z)).data() << 4;
-
-            if (near_plane <= vcz) [[likely]]
-            {
-                int vcx = (vrx.unsafe_multiplication(camera_u_x) +
-                           vry.unsafe_multiplication(camera_u_y) +
-                           vrz.unsafe_multiplication(camera_u_z))
-                              .data();
-                int vcy = -(vrx.unsafe_multiplication(camera_v_x) +
-                            vry.unsafe_multiplication(camera_v_y) +
-                            vrz.unsafe_multiplication(camera_v_z))
-                               .data();
-
-                // int scale = (1 << (focal_length_shift + 16 + 4)) / vcz;
-                auto scale = int(
-                    (div_lut_ptr[vcz >> 10] << (focal_length_shift - 8)) >> 6);
+            dropped_faces_count += model_item->faces().size();
+            continue;
+        }
 
-                *projected_vertices = {
-                    int16_t(((vcx * scale) >> 16) + (display_width / 2)),
-                    int16_t(((vcy * scale) >> 16) + (display_height / 2))};
+        int projected_vertices_count = project_vertices(
+            model_vertices, model_vertices_count, projected_vertices,
+            projection);
+        bool valid_model = projected_vertices_count == model_vertices_count;
+        bool behind_vertices = false;
 
-                ++projected_vertices;
-            }
-            else
+        // Merged models only drop the sub-ranges with vertices behind the
+        // near plane, so the remaining vertices are projected too:
+        if (!valid_model && !model_item->sub_ranges().empty())
+        {
+            while (projected_vertices_count < model_vertices_count)
             {
-                valid_model = false;
-                break;
+                projected_vertices[projected_vertices_count] = {
+                    behind_vertex_x, 0};
+                ++projected_vertices_count;
+                projected_vertices_count += project_vertices(
+                    model_vertices + projected_vertices_count,
+                    model_vertices_count - projected_vertices_count,
+                    projected_vertices + projected_vertices_count, projection);
             }
+
+            valid_model = true;
+            behind_vertices = true;
         }
 
         if (valid_model) [[likely]]
         {
-            const face_3d *model_faces = model_item->faces().data();
             int model_faces_count = model_item->faces().size();
             projected_vertices = _projected_vertices + global_vertex_index;
 
-            for (int index = model_faces_count - 1; index >= 0; --index)
-            {
-                const face_3d &face = model_faces[index];
-                const point_3d &centroid = face.centroid().point();
-                const point_3d &normal = face.normal().point();
-                point_3d vr = centroid - camera_position;
-
-                if (vr.safe_dot_product(normal) < 0) [[likely]]
+            auto add_faces = [&](const auto &model_faces, int first_index,
+                                 int last_index, const bn::color *palette,
+                                 bool test_faces) {
+                for (int index = last_index; index >= first_index; --index)
                 {
-                    // >>4 to avoid overflow; no <<4 needed — used for sort only.
-                    int projected_z = -(bn::fixed::from_data(vr.x().data() >> 4).unsafe_multiplication(camera_w_x) +
-                                        bn::fixed::from_data(vr.y().data() >> 4).unsafe_multiplication(camera_w_y) +
-                                        bn::fixed::from_data(vr.z().data() >> 4).unsafe_multiplication(camera_w_z)).data();
-                    int color_index_override = -1;
+                    const point_3d &centroid = model_faces.centroid(index);
+                    const point_3d &normal = model_faces.normal(index);
+                    point_3d vr = centroid - camera_position;
 
-                    if (_color_mapping)
+                    if (!test_faces || vr.safe_dot_product(normal) < 0)
+                        [[likely]]
                     {
-                        if (model_item->palette())
+                        // >>4 to avoid overflow; no <<4 needed — used for sort only.
+                        int projected_z = -(bn::fixed::from_data(vr.x().data() >> 4).unsafe_multiplication(camera_w_x) +
+                                            bn::fixed::from_data(vr.y().data() >> 4).unsafe_multiplication(camera_w_y) +
+                                            bn::fixed::from_data(vr.z().data() >> 4).unsafe_multiplication(camera_w_z)).data();
+                        int color_index = model_faces.color_index(index);
+
+                        if (_color_mapping)
                         {
-                            color_index_override = _color_mapping->get_index(
-                                face.color_index(), model_item->palette());
+                            if (palette)
+                            {
+                                int mapped_color_index =
+                                    _color_mapping->get_index(color_index,
+                                                              palette);
+
+                                if (mapped_color_index != -1)
+                                {
+                                    color_index = mapped_color_index;
+                                }
+                            }
+                        }
+
+                        add_valid_face({&model_faces.indexes(index),
+                                        projected_vertices, projected_z,
+                                        int16_t(color_index),
+                                        int8_t(model_faces.shading(index)),
+                                        model_faces.triangle(index)});
+                    }
+                }
+            };
+
+            auto add_clustered_faces =
+                [&](const auto &model_faces,
+                    const bn::span<const face_cluster_3d> &face_clusters,
+                    int first_index, int last_index,
+                    const bn::color *palette) {
+                    if (face_clusters.empty())
+                    {
+                        add_faces(model_faces, first_index, last_index,
+                                  palette, true);
+                        return;
+                    }
+
+                    for (int cluster_index = face_clusters.size() - 1;
+                         cluster_index >= 0; --cluster_index)
+                    {
+                        const face_cluster_3d &cluster =
+                            face_clusters[cluster_index];
+                        cluster_visibility visibility =
+                            face_cluster_visibility(cluster, point_3d(),
+                                                    camera_position);
+
+                        if (visibility != cluster_visibility::hidden)
+                        {
+                            int first_cluster_face_index =
+                                cluster.first_face_index();
+                            add_faces(model_faces, first_cluster_face_index,
+                                      first_cluster_face_index +
+                                          cluster.faces_count() - 1,
+                                      palette,
+                                      visibility ==
+                                          cluster_visibility::partial);
                         }
                     }
+                };
 
-                    _valid_faces_info[valid_faces_count] = {
-                        &face, projected_vertices, projected_z,
-                        color_index_override};
+            // Returns true if a face of the given sub-range has a vertex
+            // behind the near plane:
+            auto sub_range_behind = [&](const auto &model_faces,
+                                        const model_3d_sub_range &sub_range) {
+                int first_index = sub_range.first_face_index();
+                int last_index = first_index + sub_range.faces_count() - 1;
 
-                    ++valid_faces_count;
+                for (int index = last_index; index >= first_index; --index)
+                {
+                    const face_indexes_3d &indexes =
+                        model_faces.indexes(index);
+
+                    if (projected_vertices[indexes.first].x ==
+                            behind_vertex_x ||
+                        projected_vertices[indexes.second].x ==
+                            behind_vertex_x ||
+                        projected_vertices[indexes.third].x ==
+                            behind_vertex_x ||
+                        projected_vertices[indexes.fourth].x ==
+                            behind_vertex_x)
+                    {
+                        return true;
+                    }
                 }
+
+                return false;
+            };
+
+            auto add_model_faces = [&](const auto &model_faces) {
+                const bn::span<const face_cluster_3d> &face_clusters =
+                    model_item->face_clusters();
+                const bn::span<const model_3d_sub_range> &sub_ranges =
+                    model_item->sub_ranges();
+
+                if (sub_ranges.empty())
+                {
+                    add_clustered_faces(model_faces, face_clusters, 0,
+                                        model_faces_count - 1,
+                                        model_item->palette());
+                    return;
+                }
+
+                for (int sub_range_index = sub_ranges.size() - 1;
+                     sub_range_index >= 0; --sub_range_index)
+                {
+                    const model_3d_sub_range &sub_range =
+                        sub_ranges[sub_range_index];
+
+                    if (behind_vertices &&
+                        sub_range_behind(model_faces, sub_range)) [[unlikely]]
+                    {
+                        continue;
+                    }
+
+                    int first_index = sub_range.first_face_index();
+                    add_clustered_faces(
+                        model_faces,
+                        bn::span<const face_cluster_3d>(
+                            face_clusters.data() +
+                                sub_range.first_cluster_index(),
+                            sub_range.clusters_count()),
+                        first_index,
+                        first_index + sub_range.faces_count() - 1,
+                        sub_range.palette());
+                }
+            };
+
+            if (const packed_faces_3d *packed_faces =
+                    model_item->packed_faces())
+            {
+                add_model_faces(packed_faces_reader(*packed_faces));
+            }
+            else
+            {
+                add_model_faces(faces_reader(model_item->faces().data()));
             }
 
             global_vertex_index += model_vertices_count;
@@ -161,112 +612,235 @@ void models_3d::_process_models(const camera_3d &camera)
     }
 
     FR_PROFILER_STOP();
+    FR_GOVERNOR_STOP();
 
     // Project dynamic models:
 
     FR_PROFILER_START("dynamic_project");
+    FR_GOVERNOR_START();
+
+    // Rotated and scaled face centroids and normals are cached in consecutive
+    // ranges, in the same order as the dynamic models list. A model range is
+    // valid while its pose and its offset don't change:
+    int transformed_faces_offset = 0;
 
     for (model_3d &model : _dynamic_models_list)
     {
         const model_3d_item &model_item = model.item();
-        const vertex_3d *model_vertices = model_item.vertices().data();
-        point_2d *projected_vertices =
-            _projected_vertices + global_vertex_index;
-        int model_vertices_count = model_item.vertices().size();
-        bool valid_model = true;
+        const model_3d_bounding_sphere &bounding_sphere =
+            model_item.bounding_sphere();
+        int model_faces_offset = transformed_faces_offset;
+        transformed_faces_offset += model_item.faces().size();
         model.update();
 
-        for (int index = 0; index < model_vertices_count; ++index)
+        int bounding_sphere_radius = bounding_sphere.integer_radius();
+        bn::fixed model_scale = model.scale();
+
+        if (model_scale != 1)
         {
-            point_3d model_point = model.transform(model_vertices[index]);
+            bounding_sphere_radius =
+                (model_scale * bounding_sphere_radius).ceil_integer();
+        }
 
-            // Bit shifting to avoid overflow
-            bn::fixed vrx = bn::fixed::from_data((model_point.x() - camera_position.x()).data() >> 4);
-            bn::fixed vry = bn::fixed::from_data((model_point.y() - camera_position.y()).data() >> 4);
-            bn::fixed vrz = bn::fixed::from_data((model_point.z() - camera_position.z()).data() >> 4);
-            int vcz = -(vrx.unsafe_multiplication(camera_w_x) +
-                        vry.unsafe_multiplication(camera_w_y) +
-                        vrz.unsafe_multiplication(camera_w_z)).data() << 4;
+        int depth;
 
-            if (near_plane <= vcz) [[likely]]
-            {
-                int vcx = (vrx.unsafe_multiplication(camera_u_x) +
-                           vry.unsafe_multiplication(camera_u_y) +
-                           vrz.unsafe_multiplication(camera_u_z))
-                              .data();
-                int vcy = -(vrx.unsafe_multiplication(camera_v_x) +
-                            vry.unsafe_multiplication(camera_v_y) +
-                            vrz.unsafe_multiplication(camera_v_z))
-                               .data();
+        if (!sphere_in_frustum(model.transform(bounding_sphere.center()),
+                               bounding_sphere_radius, depth))
+        {
+            continue;
+        }
 
-                // int scale = (1 << (focal_length_shift + 16 + 4)) / vcz;
-                auto scale = int(
-                    (div_lut_ptr[vcz >> 10] << (focal_length_shift - 8)) >> 6);
+        // Lower detail levels and models out of the faces budget don't use
+        // the transformed faces cache:
+        const model_3d_item &detail_item =
+            *select_detail(&model_item, (depth * lod_depth_scale) >> 4);
+        bool cached_faces = &detail_item == &model_item &&
+                            transformed_faces_offset <= _max_faces;
 
-                *projected_vertices = {
-                    int16_t(((vcx * scale) >> 16) + (display_width / 2)),
-                    int16_t(((vcy * scale) >> 16) + (display_height / 2))};
+        const vertex_3d *model_vertices = detail_item.vertices().data();
+        point_2d *projected_vertices =
+            _projected_vertices + global_vertex_index;
+        int model_vertices_count = detail_item.vertices().size();
 
-                ++projected_vertices;
-            }
-            else
+        if (global_vertex_index + model_vertices_count > _max_vertices)
+            [[unlikely]]
+        {
+            dropped_faces_count += detail_item.faces().size();
+            continue;
+        }
+
+        bool translation_only = model.translation_only();
+        point_3d model_position = model.position();
+
+        bool valid_model = true;
+
+        if (translation_only)
+        {
+            // (vertex + position) - camera == vertex - (camera - position):
+            vertex_projection::params model_projection = projection;
+            model_projection.offset_x -= model_position.x().data();
+            model_projection.offset_y -= model_position.y().data();
+            model_projection.offset_z -= model_position.z().data();
+            valid_model = project_vertices(model_vertices, model_vertices_count,
+                                           projected_vertices,
+                                           model_projection) ==
+                          model_vertices_count;
+        }
+        else
+        {
+            for (int index = 0; index < model_vertices_count; ++index)
             {
-                valid_model = false;
-                break;
+                if (!vertex_projection::project_point(
+                        model.transform(model_vertices[index]), projection,
+                        projected_vertices[index])) [[unlikely]]
+                {
+                    valid_model = false;
+                    break;
+                }
             }
         }
 
         if (valid_model) [[likely]]
         {
-            const face_3d *model_faces = model_item.faces().data();
-            int model_faces_count = model_item.faces().size();
+            int model_faces_count = detail_item.faces().size();
             projected_vertices = _projected_vertices + global_vertex_index;
 
-            for (int index = model_faces_count - 1; index >= 0; --index)
-            {
-                const face_3d &face = model_faces[index];
-                point_3d centroid = model.transform(face.centroid());
-                point_3d normal = model.rotate(face.normal());
-                point_3d vr = centroid - camera_position;
+            point_3d *transformed_centroids =
+                _render_cache.transformed_face_centroids + model_faces_offset;
+            point_3d *transformed_normals =
+                _render_cache.transformed_face_normals + model_faces_offset;
+            bool transformed_faces_cached =
+                model.transformed_faces_offset() == model_faces_offset;
 
-                if (vr.safe_dot_product(normal) < 0) [[likely]]
+            auto add_faces = [&](const auto &model_faces, int first_index,
+                                 int last_index, bool test_faces) {
+                for (int index = last_index; index >= first_index; --index)
                 {
-                    int projected_z = -(bn::fixed::from_data(vr.x().data() >> 4).unsafe_multiplication(camera_w_x) +
-                                        bn::fixed::from_data(vr.y().data() >> 4).unsafe_multiplication(camera_w_y) +
-                                        bn::fixed::from_data(vr.z().data() >> 4).unsafe_multiplication(camera_w_z)).data();
-                    int color_index_override = -1;
+                    point_3d centroid;
+                    point_3d normal;
 
-                    if (_color_mapping)
+                    if (translation_only)
+                    {
+                        centroid = model_faces.centroid(index) + model_position;
+                        normal = model_faces.normal(index);
+                    }
+                    else if (!cached_faces)
                     {
-                        if (model.palette())
+                        centroid =
+                            model.transform(model_faces.centroid_vertex(index));
+                        normal = model.rotate(model_faces.normal_vertex(index));
+                    }
+                    else
+                    {
+                        if (!transformed_faces_cached)
                         {
-                            color_index_override = _color_mapping->get_index(
-                                face.color_index(), model.palette());
+                            transformed_centroids[index] = model.rotate_and_scale(
+                                model_faces.centroid_vertex(index));
+                            transformed_normals[index] =
+                                model.rotate(model_faces.normal_vertex(index));
                         }
-                        else if (model_item.palette())
+
+                        centroid = transformed_centroids[index] + model_position;
+                        normal = transformed_normals[index];
+                    }
+
+                    point_3d vr = centroid - camera_position;
+
+                    if (!test_faces || vr.safe_dot_product(normal) < 0)
+                        [[likely]]
+                    {
+                        int projected_z = -(bn::fixed::from_data(vr.x().data() >> 4).unsafe_multiplication(camera_w_x) +
+                                            bn::fixed::from_data(vr.y().data() >> 4).unsafe_multiplication(camera_w_y) +
+                                            bn::fixed::from_data(vr.z().data() >> 4).unsafe_multiplication(camera_w_z)).data();
+                        int color_index = model_faces.color_index(index);
+
+                        if (_color_mapping)
                         {
-                            color_index_override = _color_mapping->get_index(
-                                face.color_index(), model_item.palette());
+                            const bn::color *palette = model.palette();
+
+                            if (!palette)
+                            {
+                                palette = model_item.palette();
+                            }
+
+                            if (palette)
+                            {
+                                int mapped_color_index =
+                                    _color_mapping->get_index(color_index,
+                                                              palette);
+
+                                if (mapped_color_index != -1)
+                                {
+                                    color_index = mapped_color_index;
+                                }
+                            }
                         }
+
+                        add_valid_face({&model_faces.indexes(index),
+                                        projected_vertices, projected_z,
+                                        int16_t(color_index),
+                                        int8_t(model_faces.shading(index)),
+                                        model_faces.triangle(index)});
                     }
+                }
+            };
+
+            // Clusters aren't rotated, so they are only used by translation
+            // only models:
+            auto add_model_faces = [&](const auto &model_faces) {
+                const bn::span<const face_cluster_3d> &face_clusters =
+                    detail_item.face_clusters();
+
+                if (!translation_only || face_clusters.empty())
+                {
+                    add_faces(model_faces, 0, model_faces_count - 1, true);
+                    return;
+                }
 
-                    _valid_faces_info[valid_faces_count] = {
-                        &face, projected_vertices, projected_z,
-                        color_index_override};
+                for (int cluster_index = face_clusters.size() - 1;
+                     cluster_index >= 0; --cluster_index)
+                {
+                    const face_cluster_3d &cluster =
+                        face_clusters[cluster_index];
+                    cluster_visibility visibility = face_cluster_visibility(
+                        cluster, model_position, camera_position);
 
-                    ++valid_faces_count;
+                    if (visibility != cluster_visibility::hidden)
+                    {
+                        int first_index = cluster.first_face_index();
+                        add_faces(model_faces, first_index,
+                                  first_index + cluster.faces_count() - 1,
+                                  visibility == cluster_visibility::partial);
+                    }
                 }
+            };
+
+            if (const packed_faces_3d *packed_faces =
+                    detail_item.packed_faces())
+            {
+                add_model_faces(packed_faces_reader(*packed_faces));
+            }
+            else
+            {
+                add_model_faces(faces_reader(detail_item.faces().data()));
             }
 
+            if (!translation_only && cached_faces)
+            {
+                model.set_transformed_faces_offset(model_faces_offset);
+            }
             global_vertex_index += model_vertices_count;
         }
     }
 
     FR_PROFILER_STOP();
+    FR_GOVERNOR_STOP();
+
+    _valid_faces_count = valid_faces_count;
 
     // Cull valid faces:
 
-    visible_face_info *visible_faces = _visible_faces_info;
+    visible_face_info *visible_faces = _render_arena.visible_faces_info;
     int visible_faces_count = 0;
 
     FR_PROFILER_START("cull_valid_faces");
@@ -274,12 +848,12 @@ void models_3d::_process_models(const camera_3d &camera)
     for (int face_index = valid_faces_count - 1; face_index >= 0; --face_index)
     {
         const valid_face_info &valid_face = _valid_faces_info[face_index];
-        const face_3d *face = valid_face.face;
+        const face_indexes_3d &indexes = *valid_face.indexes;
         const point_2d *projected_vertices = valid_face.projected_vertices;
-        const point_2d &pv0 = projected_vertices[face->first_vertex_index()];
-        const point_2d &pv1 = projected_vertices[face->second_vertex_index()];
-        const point_2d &pv2 = projected_vertices[face->third_vertex_index()];
-        const point_2d &pv3 = projected_vertices[face->fourth_vertex_index()];
+        const point_2d &pv0 = projected_vertices[indexes.first];
+        const point_2d &pv1 = projected_vertices[indexes.second];
+        const point_2d &pv2 = projected_vertices[indexes.third];
+        const point_2d &pv3 = projected_vertices[indexes.fourth];
         int16_t minimum_x = pv0.x;
         int16_t maximum_x = minimum_x;
 
@@ -327,10 +901,8 @@ void models_3d::_process_models(const camera_3d &camera)
                                                       minimum_x,   maximum_x,
                                                       minimum_y,   maximum_y};
 
-                _visible_face_projected_zs[visible_faces_count] =
-                    valid_face.projected_z;
-                _visible_face_indexes[visible_faces_count] =
-                    visible_faces_count;
+                _visible_face_depth_keys[visible_faces_count] =
+                    depth_sort::key(valid_face.projected_z);
                 ++visible_faces_count;
             }
         }
@@ -342,8 +914,15 @@ void models_3d::_process_models(const camera_3d &camera)
 
     FR_PROFILER_START("sprites");
 
+    int sprites_count = 0;
+
     for (sprite_3d &sprite : _sprites_list)
     {
+        if (sprites_count == max_sprites) [[unlikely]]
+        {
+            break;
+        }
+
         const point_3d &sprite_position = sprite.position();
 
         // Bit shifting to avoid overflow
@@ -354,7 +933,8 @@ void models_3d::_process_models(const camera_3d &camera)
                     vry.unsafe_multiplication(camera_w_y) +
                     vrz.unsafe_multiplication(camera_w_z)).data() << 4;
 
-        if (near_plane <= vcz) [[likely]]
+        if (near_plane <= vcz && (!far_depth || (vcz >> 4) <= far_depth))
+            [[likely]]
         {
             int vcx = (vrx.unsafe_multiplication(camera_u_x) +
                        vry.unsafe_multiplication(camera_u_y) +
@@ -387,6 +967,14 @@ void models_3d::_process_models(const camera_3d &camera)
 
                     if (affine_scale > 0) [[likely]]
                     {
+                        // Dropped sprites must not update their affine mat,
+                        // which could still be used by the last frame:
+                        if (visible_faces_count == _max_faces) [[unlikely]]
+                        {
+                            ++dropped_faces_count;
+                            continue;
+                        }
+
                         int degrees = (camera_phi + sprite.theta())
                                           .right_shift_integer() *
                                       360;
@@ -419,10 +1007,11 @@ void models_3d::_process_models(const camera_3d &camera)
                             nullptr,        sprite_y,       int16_t(attr0),
                             int16_t(attr1), int16_t(attr2), 0};
 
-                        _visible_face_projected_zs[visible_faces_count] = vcz;
-                        _visible_face_indexes[visible_faces_count] =
-                            visible_faces_count;
+                        // >>4 to match faces projected z precision:
+                        _visible_face_depth_keys[visible_faces_count] =
+                            depth_sort::key(vcz >> 4);
                         ++visible_faces_count;
+                        ++sprites_count;
                     }
                 }
             }
@@ -431,8 +1020,12 @@ void models_3d::_process_models(const camera_3d &camera)
 
     FR_PROFILER_STOP();
 
+    _visible_faces_count = visible_faces_count;
+    _dropped_faces_count = dropped_faces_count;
+
     if (!visible_faces_count) [[unlikely]]
     {
+        _sorted_visible_faces_count = 0;
         return;
     }
 
@@ -440,18 +1033,57 @@ void models_3d::_process_models(const camera_3d &camera)
 
     FR_PROFILER_START("sort_visible_faces");
 
-    const int *projected_zs = _visible_face_projected_zs;
+    // The camera barely moves between frames, so last frame order is usually
+    // almost sorted. The incremental sort is valid with any permutation, so
+    // it's tried whenever there's a previous order, resized if faces have
+    // been added or removed:
+    face_index_type *visible_face_indexes =
+        _render_cache.sorted_visible_face_indexes;
+    int sorted_visible_faces_count = _sorted_visible_faces_count;
+    bool sorted = false;
+
+    if (sorted_visible_faces_count)
+    {
+        if (visible_faces_count != sorted_visible_faces_count)
+        {
+            depth_sort::resize_order(visible_face_indexes,
+                                     sorted_visible_faces_count,
+                                     visible_faces_count);
+            ++_depth_sort_resizes_count;
+        }
+
+        sorted = depth_sort::insertion_sort(
+            _visible_face_depth_keys, visible_face_indexes, visible_faces_count,
+            visible_faces_count * FR_DEPTH_SORT_MAX_MOVES_PER_FACE);
+
+        if (!sorted)
+        {
+            ++_depth_sort_fallbacks_count;
+        }
+    }
+
+    if (!sorted)
+    {
+        for (int index = 0; index < visible_faces_count; ++index)
+        {
+            visible_face_indexes[index] = face_index_type(index);
+        }
+
+        depth_sort::radix_sort(_visible_face_depth_keys, visible_face_indexes,
+                               _render_arena.temp_depth_keys,
+                               _render_arena.temp_visible_face_indexes,
+                               _render_arena.depth_sort_bucket_offsets,
+                               visible_faces_count);
+    }
 
-    bn::sort(_visible_face_indexes, _visible_face_indexes + visible_faces_count,
-             [projected_zs](uint8_t a, uint8_t b) {
-                 return projected_zs[a] > projected_zs[b];
-             });
+    _sorted_visible_faces_count = visible_faces_count;
 
     FR_PROFILER_STOP();
 
     // Render visible faces:
 
     FR_PROFILER_START("render_visible_faces");
+    FR_GOVERNOR_START();
 
     _shape_groups.enable_drawing();
 
@@ -459,18 +1091,18 @@ void models_3d::_process_models(const camera_3d &camera)
          visible_face_index >= 0; --visible_face_index)
     {
         const visible_face_info &visible_face =
-            visible_faces[_visible_face_indexes[visible_face_index]];
+            visible_faces[visible_face_indexes[visible_face_index]];
 
         if (const valid_face_info *valid_face = visible_face.valid_face)
             [[likely]]
         {
-            const face_3d *face = valid_face->face;
+            const face_indexes_3d &indexes = *valid_face->indexes;
             int minimum_x = visible_face.minimum_x;
             int maximum_x = visible_face.maximum_x;
             int minimum_y = visible_face.minimum_y;
             int maximum_y = visible_face.maximum_y;
 
-            shape_groups::hline hlines[bn::display::height()];
+            shape_groups::hline *hlines = _render_arena.hlines;
             bool x_outside = false;
 
             if (minimum_x < 0)
@@ -503,25 +1135,25 @@ void models_3d::_process_models(const camera_3d &camera)
                 const point_2d *projected_vertices =
                     valid_face->projected_vertices;
                 const point_2d &pv0 =
-                    projected_vertices[face->first_vertex_index()];
+                    projected_vertices[indexes.first];
                 vertices[0].x = pv0.x;
                 vertices[0].y = pv0.y;
                 vertices[0].next = &vertices[1];
 
                 const point_2d &pv1 =
-                    projected_vertices[face->second_vertex_index()];
+                    projected_vertices[indexes.second];
                 vertices[1].x = pv1.x;
                 vertices[1].y = pv1.y;
                 vertices[1].prev = &vertices[0];
                 vertices[1].next = &vertices[2];
 
                 const point_2d &pv2 =
-                    projected_vertices[face->third_vertex_index()];
+                    projected_vertices[indexes.third];
                 vertices[2].x = pv2.x;
                 vertices[2].y = pv2.y;
                 vertices[2].prev = &vertices[1];
 
-                if (face->triangle())
+                if (valid_face->triangle)
                 {
                     vertices[0].prev = &vertices[2];
                     vertices[2].next = &vertices[0];
@@ -532,7 +1164,7 @@ void models_3d::_process_models(const camera_3d &camera)
                     vertices[2].next = &vertices[3];
 
                     const point_2d &pv3 =
-                        projected_vertices[face->fourth_vertex_index()];
+                        projected_vertices[indexes.fourth];
                     vertices[3].x = pv3.x;
                     vertices[3].y = pv3.y;
                     vertices[3].prev = &vertices[2];
@@ -665,12 +1297,9 @@ void models_3d::_process_models(const camera_3d &camera)
             }
 
             int width = maximum_x - minimum_x + 1;
-            int mapped_color_index = valid_face->color_index_override == -1
-                                         ? face->color_index()
-                                         : valid_face->color_index_override;
             _shape_groups.add_hlines(unsigned(minimum_y), unsigned(maximum_y),
-                                     width, x_outside, mapped_color_index,
-                                     face->shading(), hlines);
+                                     width, x_outside, valid_face->color_index,
+                                     valid_face->shading, hlines);
         }
         else
         {
@@ -695,6 +1324,7 @@ void models_3d::_process_models(const camera_3d &camera)
     }
 
     FR_PROFILER_STOP();
+    FR_GOVERNOR_STOP();
 }
 
 } // namespace fr
@@ -5,41 +5,102 @@
 
 #include "fr_models_3d.h"
 
-#if FR_LOG_POLYGONS_PER_SECOND
+#include "bn_algorithm.h"
 #include "bn_log.h"
-#endif
+#include "bn_memory.h"
 
 namespace fr
 {
 
+namespace
+{
+constexpr uint8_t render_arena_fill_byte = 0xA5;
+
+template <typename Type, int Size>
+[[nodiscard]] int written_bytes(const Type (&buffer)[Size])
+{
+    auto bytes = reinterpret_cast<const uint8_t *>(buffer);
+    int result = int(sizeof(buffer));
+
+    while (result && bytes[result - 1] == render_arena_fill_byte)
+    {
+        --result;
+    }
+
+    return result;
+}
+} // namespace
+
 void models_3d::set_static_model_items(
     const model_3d_item **static_model_items_ptr, int static_models_count)
 {
-    BN_ASSERT(static_models_count <= constants_3d::max_static_models,
+    set_retained_static_model_items(static_model_items_ptr,
+                                    static_models_count);
+    set_transient_static_models_count(0);
+}
+
+void models_3d::set_retained_static_model_items(
+    const model_3d_item **static_model_items_ptr, int retained_models_count)
+{
+    BN_ASSERT(retained_models_count <= constants_3d::max_static_models,
               "There's no space for more static models");
 
-    int static_vertices_count = 0;
-    int static_faces_count = 0;
-    _static_models_count = static_models_count;
+    int retained_vertices_count = 0;
+    int retained_faces_count = 0;
 
-    for (int index = 0; index < static_models_count; ++index)
+    for (int index = 0; index < retained_models_count; ++index)
     {
         const model_3d_item *static_model_item = static_model_items_ptr[index];
+        retained_vertices_count += static_model_item->vertices().size();
+        retained_faces_count += static_model_item->faces().size();
+    }
+
+    if (retained_vertices_count > _max_vertices)
+    {
+        BN_LOG("Retained static models don't fit in the vertices budget: ",
+               retained_vertices_count, " - ", _max_vertices);
+    }
+
+    _static_model_items_ptr = static_model_items_ptr;
+    _retained_static_models_count = retained_models_count;
+    _retained_static_vertices_count = retained_vertices_count;
+    _retained_static_faces_count = retained_faces_count;
+    _update_static_counts(retained_vertices_count, retained_faces_count);
+    _static_models_count = retained_models_count;
+}
+
+void models_3d::set_transient_static_models_count(int transient_models_count)
+{
+    int static_models_count =
+        _retained_static_models_count + transient_models_count;
+    BN_ASSERT(transient_models_count >= 0 &&
+                  static_models_count <= constants_3d::max_static_models,
+              "There's no space for more static models");
+
+    int static_vertices_count = _retained_static_vertices_count;
+    int static_faces_count = _retained_static_faces_count;
+
+    for (int index = _retained_static_models_count;
+         index < static_models_count; ++index)
+    {
+        const model_3d_item *static_model_item = _static_model_items_ptr[index];
         static_vertices_count += static_model_item->vertices().size();
         static_faces_count += static_model_item->faces().size();
     }
 
+    _update_static_counts(static_vertices_count, static_faces_count);
+    _static_models_count = static_models_count;
+}
+
+void models_3d::_update_static_counts(int static_vertices_count,
+                                      int static_faces_count)
+{
     _vertices_count =
         _vertices_count - _static_vertices_count + static_vertices_count;
     _static_vertices_count = static_vertices_count;
-    BN_ASSERT(_vertices_count <= _max_vertices,
-              "There's no space for more vertices");
 
     _faces_count = _faces_count - _static_faces_count + static_faces_count;
     _static_faces_count = static_faces_count;
-    BN_ASSERT(_faces_count <= _max_faces, "There's no space for more faces");
-
-    _static_model_items_ptr = static_model_items_ptr;
 }
 
 model_3d &models_3d::create_dynamic_model(const model_3d_item &model_item)
@@ -48,10 +109,6 @@ model_3d &models_3d::create_dynamic_model(const model_3d_item &model_item)
     int model_faces_count = model_item.faces().size();
     BN_ASSERT(!_dynamic_models_pool.full(),
               "There's no space for more dynamic models");
-    BN_ASSERT(model_vertices_count + _vertices_count <= _max_vertices,
-              "There's no space for more vertices");
-    BN_ASSERT(model_faces_count + _faces_count <= _max_faces,
-              "There's no space for more faces");
 
     model_3d &result = _dynamic_models_pool.create(model_item);
     _dynamic_models_list.push_back(result);
@@ -81,10 +138,6 @@ sprite_3d &models_3d::create_sprite(sprite_3d_item &sprite_item)
 {
     BN_ASSERT(!_sprites_pool.full(),
               "There's no space for more dynamic sprites");
-    BN_ASSERT(1 + _vertices_count <= _max_vertices,
-              "There's no space for more vertices");
-    BN_ASSERT(1 + _faces_count <= _max_faces,
-              "There's no space for more faces");
 
     sprite_3d &result = _sprites_pool.create(sprite_item);
     _sprites_list.push_back(result);
@@ -106,6 +159,10 @@ void models_3d::update(const camera_3d &camera)
     _process_models(camera);
     _shape_groups.update();
 
+#if FR_RENDER_GOVERNOR
+    _render_governor.update(_render_ticks);
+#endif
+
 #if FR_LOG_POLYGONS_PER_SECOND
     _total_faces_count += _faces_count;
     ++_update_calls;
@@ -117,6 +174,64 @@ void models_3d::update(const camera_3d &camera)
         _update_calls = 0;
     }
 #endif
+
+#if FR_LOG_RENDER_STATS
+    int hlines = hlines_count();
+    _stats_total_valid_faces += _valid_faces_count;
+    _stats_total_visible_faces += _visible_faces_count;
+    _stats_total_hlines += hlines;
+    _stats_max_valid_faces = bn::max(_stats_max_valid_faces, _valid_faces_count);
+    _stats_max_visible_faces = bn::max(_stats_max_visible_faces, _visible_faces_count);
+    _stats_max_hlines = bn::max(_stats_max_hlines, hlines);
+    _stats_total_dropped_faces += _dropped_faces_count;
+    ++_stats_update_calls;
+
+    if (_stats_update_calls == 60)
+    {
+        BN_LOG("valid faces avg: ", _stats_total_valid_faces / 60,
+               " max: ", _stats_max_valid_faces);
+        BN_LOG("visible faces avg: ", _stats_total_visible_faces / 60,
+               " max: ", _stats_max_visible_faces);
+        BN_LOG("hlines avg: ", _stats_total_hlines / 60,
+               " max: ", _stats_max_hlines);
+        BN_LOG("depth sort fallbacks: ",
+               _depth_sort_fallbacks_count - _stats_depth_sort_fallbacks,
+               " resizes: ",
+               _depth_sort_resizes_count - _stats_depth_sort_resizes);
+        BN_LOG("dropped faces: ", _stats_total_dropped_faces);
+        BN_LOG("render quality level: ", _render_governor.quality_level());
+        BN_LOG("render arena high water mark: ",
+               render_arena_high_water_mark(), " of ", render_arena_size(),
+               " render cache: ", render_cache_size());
+        _stats_total_valid_faces = 0;
+        _stats_total_visible_faces = 0;
+        _stats_total_hlines = 0;
+        _stats_max_valid_faces = 0;
+        _stats_max_visible_faces = 0;
+        _stats_max_hlines = 0;
+        _stats_depth_sort_fallbacks = _depth_sort_fallbacks_count;
+        _stats_depth_sort_resizes = _depth_sort_resizes_count;
+        _stats_total_dropped_faces = 0;
+        _stats_update_calls = 0;
+    }
+#endif
+}
+
+int models_3d::render_arena_high_water_mark() const
+{
+    return written_bytes(_render_arena.projected_vertices) +
+           written_bytes(_render_arena.valid_faces_info) +
+           written_bytes(_render_arena.visible_faces_info) +
+           written_bytes(_render_arena.visible_face_depth_keys) +
+           written_bytes(_render_arena.temp_depth_keys) +
+           written_bytes(_render_arena.temp_visible_face_indexes) +
+           written_bytes(_render_arena.depth_sort_bucket_offsets) +
+           written_bytes(_render_arena.hlines);
+}
+
+void models_3d::_fill_render_arena()
+{
+    bn::memory::set(1, render_arena_fill_byte, _render_arena);
 }
 
 } // namespace fr
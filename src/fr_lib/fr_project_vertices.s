@@ -0,0 +1,142 @@
+@
+@ Copyright (c) 2020-2024 Gustavo Valiente gustavo.valiente@protonmail.com
+@ zlib License, see LICENSE file.
+@
+
+@ ARM mode vertex projection kernel, see models_3d::_process_models.
+@
+@ Output must be bit-exact with the C++ reference loop, so every product is
+@ truncated on its own (mul + asr #12) like bn::fixed::unsafe_multiplication,
+@ instead of accumulated with mla/smull.
+@
+@ int fr_project_vertices(const vertex_3d* vertices, int vertices_count,
+@                         point_2d* projected_vertices,
+@                         const projection_params* params)
+@
+@ Returns the number of projected vertices. It's less than vertices_count
+@ if a vertex is behind the near plane, as the kernel stops at the first one.
+
+    .section .iwram, "ax", %progbits
+    .arm
+    .align 2
+    .global fr_project_vertices
+    .type fr_project_vertices, %function
+
+@ projection_params layout:
+    .equ PARAMS_U, 12
+    .equ PARAMS_W, 36
+
+@ Stack frame:
+    .equ FRAME_OFFSET, 0
+    .equ FRAME_DIV_LUT, 12
+    .equ FRAME_U_Z, 16
+    .equ FRAME_V_X, 20
+    .equ FRAME_V_Y, 24
+    .equ FRAME_V_Z, 28
+    .equ FRAME_OUTPUT_BEGIN, 32
+    .equ FRAME_SIZE, 36
+
+    .equ VERTEX_SIZE_SHIFT, 4       @ sizeof(vertex_3d) == 16
+    .equ NEAR_PLANE, 0x18000        @ 24 * 256 * 16
+    .equ HALF_WIDTH, 120
+    .equ HALF_HEIGHT, 80
+
+@ Loop registers:
+@ r0 = vertices, r1 = vertices end, r2 = projected vertices,
+@ r4-r5 = u x and y axes, r6-r8 = w axis,
+@ r3 and r9-r12, lr = temporaries.
+@ The offset, the div LUT, the u z axis and the v axis are loaded from the
+@ stack frame in pairs when they're needed.
+
+fr_project_vertices:
+    stmfd   sp!, {r4-r11, lr}
+    sub     sp, sp, #FRAME_SIZE
+
+    str     r2, [sp, #FRAME_OUTPUT_BEGIN]
+    add     r1, r0, r1, lsl #VERTEX_SIZE_SHIFT
+    ldmia   r3!, {r4-r12}
+    stmia   sp, {r4-r6}
+    mov     r4, r7
+    mov     r5, r8
+    add     lr, sp, #FRAME_U_Z
+    stmia   lr, {r9-r12}
+    ldmia   r3, {r6-r9}
+    str     r9, [sp, #FRAME_DIV_LUT]
+    cmp     r0, r1
+    bhs     .Ldone
+
+.Lloop:
+    @ r3, r9, r10 = (vertex - offset) >> 4 (r11 gets vertex xy, which is
+    @ unused):
+    ldmia   r0!, {r3, r9-r11}
+    ldmia   sp, {r11, r12, lr}
+    sub     r3, r3, r11
+    mov     r3, r3, asr #4
+    sub     r9, r9, r12
+    mov     r9, r9, asr #4
+    sub     r10, r10, lr
+    mov     r10, r10, asr #4
+
+    @ r11 = vcz:
+    mul     r11, r3, r6
+    mov     r11, r11, asr #12
+    mul     r12, r9, r7
+    add     r11, r11, r12, asr #12
+    mul     r12, r10, r8
+    add     r11, r11, r12, asr #12
+    rsb     r11, r11, #0
+    mov     r11, r11, lsl #4
+    cmp     r11, #NEAR_PLANE
+    blt     .Ldone
+
+    @ r11 = scale = div_lut[vcz >> 10] >> 6 (lr gets the u z axis):
+    add     lr, sp, #FRAME_DIV_LUT
+    ldmia   lr, {r12, lr}
+    mov     r11, r11, asr #10
+    ldr     r11, [r12, r11, lsl #2]
+    mov     r11, r11, lsr #6
+
+    @ r12 = vcx:
+    mul     r12, r10, lr
+    mov     r12, r12, asr #12
+    mul     lr, r3, r4
+    add     r12, r12, lr, asr #12
+    mul     lr, r9, r5
+    add     r12, r12, lr, asr #12
+
+    @ Screen x:
+    mul     lr, r12, r11
+    mov     lr, lr, asr #16
+    add     lr, lr, #HALF_WIDTH
+    strh    lr, [r2], #2
+
+    @ r12 = vcy:
+    add     lr, sp, #FRAME_V_X
+    ldmia   lr, {r12, lr}
+    mul     r12, r3, r12
+    mov     r12, r12, asr #12
+    mul     r3, r9, lr
+    add     r12, r12, r3, asr #12
+    ldr     lr, [sp, #FRAME_V_Z]
+    mul     r3, r10, lr
+    add     r12, r12, r3, asr #12
+    rsb     r12, r12, #0
+
+    @ Screen y:
+    mul     r3, r12, r11
+    mov     r3, r3, asr #16
+    add     r3, r3, #HALF_HEIGHT
+    strh    r3, [r2], #2
+
+    cmp     r0, r1
+    blo     .Lloop
+
+.Ldone:
+    ldr     r1, [sp, #FRAME_OUTPUT_BEGIN]
+    sub     r0, r2, r1
+    mov     r0, r0, lsr #2
+    add     sp, sp, #FRAME_SIZE
+    ldmfd   sp!, {r4-r11, lr}
+    bx      lr
+
+    .size fr_project_vertices, .-fr_project_vertices
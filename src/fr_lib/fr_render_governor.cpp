@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020-2024 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "fr_render_governor.h"
+
+#include "bn_timers.h"
+
+namespace fr
+{
+
+namespace
+{
+struct quality_settings
+{
+    int lod_depth_scale;
+    int max_sprites;
+    int far_distance;
+};
+
+constexpr quality_settings quality_levels[] = {
+    {16, constants_3d::max_sprites, 0},
+    {24, constants_3d::max_sprites, 0},
+    {32, constants_3d::max_sprites / 2, 640},
+    {48, constants_3d::max_sprites / 4, 480},
+};
+
+static_assert(sizeof(quality_levels) / sizeof(quality_levels[0]) ==
+              render_governor::max_quality_level + 1);
+} // namespace
+
+int render_governor::lod_depth_scale() const
+{
+    return quality_levels[_quality_level].lod_depth_scale;
+}
+
+int render_governor::max_sprites() const
+{
+    return quality_levels[_quality_level].max_sprites;
+}
+
+int render_governor::far_depth() const
+{
+    return quality_levels[_quality_level].far_distance << 8;
+}
+
+void render_governor::update(int render_ticks)
+{
+    int ticks_per_frame = bn::timers::ticks_per_frame();
+    int budget_ticks =
+        ticks_per_frame * FR_RENDER_GOVERNOR_BUDGET_PERCENT / 100;
+    bool dropped_frame = false;
+    _render_ticks = render_ticks;
+
+    // Long pauses between updates (loading, pause menus) aren't dropped
+    // frames:
+    if (_frame_timer_started)
+    {
+        int frame_ticks = _frame_timer.elapsed_ticks_with_restart();
+        dropped_frame = frame_ticks > ticks_per_frame + (ticks_per_frame / 2) &&
+                        frame_ticks < ticks_per_frame * 4;
+    }
+    else
+    {
+        _frame_timer.restart();
+        _frame_timer_started = true;
+    }
+
+    // A single slow frame (a burst of explosions, a section being loaded)
+    // doesn't lower quality:
+    if (dropped_frame || render_ticks > budget_ticks)
+    {
+        if (_quality_level < max_quality_level &&
+            ++_over_budget_frames >= FR_RENDER_GOVERNOR_OVER_BUDGET_FRAMES)
+        {
+            ++_quality_level;
+            _over_budget_frames = 0;
+        }
+
+        _headroom_frames = 0;
+    }
+    else if (render_ticks < budget_ticks - (budget_ticks / 4))
+    {
+        if (_quality_level > 0 &&
+            ++_headroom_frames >= FR_RENDER_GOVERNOR_RESTORE_FRAMES)
+        {
+            --_quality_level;
+            _headroom_frames = 0;
+        }
+
+        _over_budget_frames = 0;
+    }
+    else
+    {
+        _headroom_frames = 0;
+        _over_budget_frames = 0;
+    }
+}
+
+} // namespace fr
@@ -13,6 +13,16 @@ namespace fr
     namespace
     {
         constexpr int split_length = 64 - 2;
+
+        // Each hline is drawn with the row of a triangle texture as long as the hline, so sprite y depends on both
+        // the screen line and the hline length.
+        // Since HDMA rewrites every sprite slot on each screen line, runs of screen lines with the same xl and xr
+        // can't share a taller sprite: each line of the run still needs its own slot and its own sprite y.
+        [[nodiscard]] inline uint16_t hline_first_attributes(int sprite_y)
+        {
+            return uint16_t(bn::hw::sprites::first_attributes(
+                sprite_y, bn::sprite_shape::SQUARE, bn::bpp_mode::BPP_4, 0, true, false, false, false));
+        }
     }
 
     void shape_groups::add_hlines(unsigned minimum_y, unsigned maximum_y, int width, bool x_outside, int color_index,
@@ -20,6 +30,7 @@ namespace fr
     {
         const color_tiles_ids &tiles_ids = _color_tiles_ids[color_index];
         uint8_t palette_id = _palette_ids[shading];
+        unsigned key = ((unsigned(color_index) << 3) | shading) + 1;
         int attr1;
         int attr2;
         bool split;
@@ -70,30 +81,34 @@ namespace fr
 
                         if (xr >= 0) [[likely]]
                         {
+                            if (xl < 0)
+                            {
+                                xl = 0;
+                            }
+
+                            if (xr > bn::display::width() - 1)
+                            {
+                                xr = bn::display::width() - 1;
+                            }
+
+                            if (_cover_hline(y, xl, xr) || _merge_hline(y, xl, xr, key, tiles_ids, palette_id))
+                            {
+                                continue;
+                            }
+
                             int hlines_count = _hlines_count[y];
 
                             if (hlines_count < _max_hdma_sprites) [[likely]]
                             {
                                 _hlines_count[y] = hlines_count + 1;
+                                _last_hlines[y] = { int16_t(xl), int16_t(xr), uint16_t(key) };
 
                                 uint16_t *sprite_hdma_source = hdma_source + (y * screen_line_elements);
                                 sprite_hdma_source += hlines_count * 4;
 
-                                if (xl < 0)
-                                {
-                                    xl = 0;
-                                }
-
-                                if (xr > bn::display::width() - 1)
-                                {
-                                    xr = bn::display::width() - 1;
-                                }
-
                                 int length = xr - xl;
                                 int sprite_y = int(y) - length;
-                                sprite_hdma_source[0] = bn::hw::sprites::first_attributes(
-                                    sprite_y, bn::sprite_shape::SQUARE, bn::bpp_mode::BPP_4, 0,
-                                    true, false, false, false);
+                                sprite_hdma_source[0] = hline_first_attributes(sprite_y);
 
                                 sprite_hdma_source[1] = attr1 + xl;
 
@@ -107,22 +122,27 @@ namespace fr
             {
                 for (unsigned y = minimum_y; y <= maximum_y; ++y)
                 {
+                    int xl = hlines[y].xl;
+                    int xr = hlines[y].xr;
+
+                    if (_cover_hline(y, xl, xr) || _merge_hline(y, xl, xr, key, tiles_ids, palette_id))
+                    {
+                        continue;
+                    }
+
                     int hlines_count = _hlines_count[y];
 
                     if (hlines_count < _max_hdma_sprites) [[likely]]
                     {
                         _hlines_count[y] = hlines_count + 1;
+                        _last_hlines[y] = { int16_t(xl), int16_t(xr), uint16_t(key) };
 
                         uint16_t *sprite_hdma_source = hdma_source + (y * screen_line_elements);
                         sprite_hdma_source += hlines_count * 4;
 
-                        int xl = hlines[y].xl;
-                        int xr = hlines[y].xr;
                         int length = xr - xl;
                         int sprite_y = int(y) - length;
-                        sprite_hdma_source[0] = bn::hw::sprites::first_attributes(
-                            sprite_y, bn::sprite_shape::SQUARE, bn::bpp_mode::BPP_4, 0,
-                            true, false, false, false);
+                        sprite_hdma_source[0] = hline_first_attributes(sprite_y);
 
                         sprite_hdma_source[1] = attr1 + xl;
 
@@ -155,10 +175,24 @@ namespace fr
                                 xr = bn::display::width() - 1;
                             }
 
+                            if (_cover_hline(y, xl, xr) || _merge_hline(y, xl, xr, key, tiles_ids, palette_id))
+                            {
+                                continue;
+                            }
+
                             int hlines_count = _hlines_count[y];
                             uint16_t *sprite_hdma_source = hdma_source + (y * screen_line_elements);
                             sprite_hdma_source += hlines_count * 4;
 
+                            if (xr - xl <= split_length && hlines_count < _max_hdma_sprites)
+                            {
+                                _last_hlines[y] = { int16_t(xl), int16_t(xr), uint16_t(key) };
+                            }
+                            else
+                            {
+                                _last_hlines[y].key = 0;
+                            }
+
                             bool keep_adding;
 
                             do
@@ -179,9 +213,7 @@ namespace fr
                                         sprite_y = int(y) - length;
                                     }
 
-                                    sprite_hdma_source[0] = bn::hw::sprites::first_attributes(
-                                        sprite_y, bn::sprite_shape::SQUARE, bn::bpp_mode::BPP_4, 0,
-                                        true, false, false, false);
+                                    sprite_hdma_source[0] = hline_first_attributes(sprite_y);
 
                                     sprite_hdma_source[1] = attr1 + xl;
 
@@ -208,10 +240,24 @@ namespace fr
                     int xl = hlines[y].xl;
                     int xr = hlines[y].xr;
 
+                    if (_cover_hline(y, xl, xr) || _merge_hline(y, xl, xr, key, tiles_ids, palette_id))
+                    {
+                        continue;
+                    }
+
                     int hlines_count = _hlines_count[y];
                     uint16_t *sprite_hdma_source = hdma_source + (y * screen_line_elements);
                     sprite_hdma_source += hlines_count * 4;
 
+                    if (xr - xl <= split_length && hlines_count < _max_hdma_sprites)
+                    {
+                        _last_hlines[y] = { int16_t(xl), int16_t(xr), uint16_t(key) };
+                    }
+                    else
+                    {
+                        _last_hlines[y].key = 0;
+                    }
+
                     bool keep_adding;
 
                     do
@@ -232,9 +278,7 @@ namespace fr
                                 sprite_y = int(y) - length;
                             }
 
-                            sprite_hdma_source[0] = bn::hw::sprites::first_attributes(
-                                sprite_y, bn::sprite_shape::SQUARE, bn::bpp_mode::BPP_4, 0,
-                                true, false, false, false);
+                            sprite_hdma_source[0] = hline_first_attributes(sprite_y);
 
                             sprite_hdma_source[1] = attr1 + xl;
 
@@ -267,6 +311,7 @@ namespace fr
             if (hlines_count < _max_hdma_sprites) [[likely]]
             {
                 _hlines_count[y] = hlines_count + 1;
+                _last_hlines[y].key = 0;
 
                 uint16_t *sprite_hdma_source = hdma_source + (y * screen_line_elements);
                 sprite_hdma_source += hlines_count * 4;
@@ -280,20 +325,185 @@ namespace fr
         }
     }
 
-    void shape_groups::_hide_left_hlines(const uint8_t *previous_hlines_count)
+    bool shape_groups::_cover_hline([[maybe_unused]] unsigned y, [[maybe_unused]] int xl,
+                                    [[maybe_unused]] int xr)
     {
+        #if FR_COVERAGE_BUFFER
+            coverage_line &line = _coverage_lines[y];
+            int16_t *xls = line.xls;
+            int16_t *xrs = line.xrs;
+            int count = line.count;
+            int first_index = 0;
+
+            while (first_index < count && xrs[first_index] < xl - 1)
+            {
+                ++first_index;
+            }
+
+            if (first_index < count && xls[first_index] <= xl && xrs[first_index] >= xr)
+            {
+                return true;
+            }
+
+            // Merge the new interval with the ones it touches:
+            int last_index = first_index;
+
+            while (last_index < count && xls[last_index] <= xr + 1)
+            {
+                if (xls[last_index] < xl)
+                {
+                    xl = xls[last_index];
+                }
+
+                if (xrs[last_index] > xr)
+                {
+                    xr = xrs[last_index];
+                }
+
+                ++last_index;
+            }
+
+            int merged_count = last_index - first_index;
+
+            if (! merged_count)
+            {
+                if (count == FR_COVERAGE_MAX_INTERVALS) [[unlikely]]
+                {
+                    return false;
+                }
+
+                for (int index = count; index > first_index; --index)
+                {
+                    xls[index] = xls[index - 1];
+                    xrs[index] = xrs[index - 1];
+                }
+
+                ++count;
+            }
+            else if (merged_count > 1)
+            {
+                for (int index = last_index; index < count; ++index)
+                {
+                    xls[index - merged_count + 1] = xls[index];
+                    xrs[index - merged_count + 1] = xrs[index];
+                }
+
+                count -= merged_count - 1;
+            }
+
+            xls[first_index] = int16_t(xl);
+            xrs[first_index] = int16_t(xr);
+            line.count = count;
+        #endif
+
+        return false;
+    }
+
+    bool shape_groups::_merge_hline(unsigned y, int xl, int xr, unsigned key, const color_tiles_ids &tiles_ids,
+                                    int palette_id)
+    {
+        last_hline &last = _last_hlines[y];
+
+        if (last.key != key) [[likely]]
+        {
+            return false;
+        }
+
+        int last_xl = last.xl;
+        int last_xr = last.xr;
+
+        if (xl > last_xr + 1 || xr < last_xl - 1)
+        {
+            return false;
+        }
+
+        if (xl > last_xl)
+        {
+            xl = last_xl;
+        }
+
+        if (xr < last_xr)
+        {
+            xr = last_xr;
+        }
+
+        int length = xr - xl;
+
+        if (length > split_length)
+        {
+            return false;
+        }
+
+        // Same color and no other hline in between, so the last hline can be replaced by the merged one:
+        bn::sprite_size size;
+        int tiles_id;
+
+        if (length < 8)
+        {
+            size = bn::sprite_size::SMALL;
+            tiles_id = tiles_ids.small_tiles_id;
+        }
+        else if (length < 16)
+        {
+            size = bn::sprite_size::NORMAL;
+            tiles_id = tiles_ids.normal_tiles_id;
+        }
+        else if (length < 32)
+        {
+            size = bn::sprite_size::BIG;
+            tiles_id = tiles_ids.big_tiles_id;
+        }
+        else
+        {
+            size = bn::sprite_size::HUGE;
+            tiles_id = tiles_ids.huge_tiles_id;
+        }
+
+        uint16_t *sprite_hdma_source = _hdma_source + (y * _max_hdma_sprites * 4);
+        sprite_hdma_source += (_hlines_count[y] - 1) * 4;
+        sprite_hdma_source[0] = hline_first_attributes(int(y) - length);
+        sprite_hdma_source[1] = bn::hw::sprites::second_attributes(xl, size, false, false);
+        sprite_hdma_source[2] = bn::hw::sprites::third_attributes(tiles_id & 0x3FF, palette_id & 0xF,
+                                                                  _sprite_priority & 3);
+        last.xl = int16_t(xl);
+        last.xr = int16_t(xr);
+        return true;
+    }
+
+    void shape_groups::_pack_hlines(int hdma_sprites_count)
+    {
+        // Hlines are added with a fixed stride of _max_hdma_sprites per screen line.
+        // They are moved in place to a stride of hdma_sprites_count, and unused sprites are hidden:
         uint16_t *hdma_source = _hdma_source;
         int screen_line_elements = _max_hdma_sprites * 4;
+        int packed_line_elements = hdma_sprites_count * 4;
 
         for (int y = 0; y < bn::display::height(); ++y)
         {
-            uint16_t *sprite_hdma_source = hdma_source + (y * screen_line_elements);
+            const uint16_t *sprite_hdma_source = hdma_source + (y * screen_line_elements);
+            uint16_t *packed_hdma_source = hdma_source + (y * packed_line_elements);
             int hlines_count = _hlines_count[y];
-            int hlines_previous_count = previous_hlines_count[y];
 
-            for (int hlines_index = hlines_count; hlines_index < hlines_previous_count; ++hlines_index)
+            if (packed_hdma_source != sprite_hdma_source)
+            {
+                for (int hlines_index = 0; hlines_index < hlines_count; ++hlines_index)
+                {
+                    packed_hdma_source[0] = sprite_hdma_source[0];
+                    packed_hdma_source[1] = sprite_hdma_source[1];
+                    packed_hdma_source[2] = sprite_hdma_source[2];
+                    packed_hdma_source += 4;
+                    sprite_hdma_source += 4;
+                }
+            }
+            else
+            {
+                packed_hdma_source += hlines_count * 4;
+            }
+
+            for (int hlines_index = hlines_count; hlines_index < hdma_sprites_count; ++hlines_index)
             {
-                sprite_hdma_source[hlines_index * 4] = ATTR0_HIDE;
+                packed_hdma_source[0] = ATTR0_HIDE;
+                packed_hdma_source += 4;
             }
         }
     }
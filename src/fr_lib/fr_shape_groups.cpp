@@ -5,6 +5,7 @@
 
 #include "fr_shape_groups.h"
 
+#include "bn_algorithm.h"
 #include "bn_hdma.h"
 #include "bn_memory.h"
 #include "bn_sprites.h"
@@ -66,15 +67,35 @@ namespace fr
         }
     }
 
-    shape_groups::shape_groups()
+    shape_groups::shape_groups(int max_hdma_sprites) :
+        _max_hdma_sprites(max_hdma_sprites),
+        _last_peak_hlines_count(max_hdma_sprites)
     {
-        for (int index = 0; index < _hdma_source_size; index += 4)
+        BN_ASSERT(max_hdma_sprites >= 0 && max_hdma_sprites <= constants_3d::max_hdma_sprites,
+                  "Invalid max HDMA sprites: ", max_hdma_sprites);
+
+        if (max_hdma_sprites)
         {
-            bn::hw::sprites::hide_and_destroy(_hdma_source_a[index]);
-            bn::hw::sprites::hide_and_destroy(_hdma_source_b[index]);
+            int hdma_source_size = (bn::display::height() + 1) * 4 * max_hdma_sprites;
+            _hdma_source_a = new uint16_t[hdma_source_size];
+            _hdma_source_b = new uint16_t[hdma_source_size];
+            _hdma_source = _hdma_source_a;
+
+            for (int index = 0; index < hdma_source_size; index += 4)
+            {
+                bn::hw::sprites::hide_and_destroy(_hdma_source_a[index]);
+                bn::hw::sprites::hide_and_destroy(_hdma_source_b[index]);
+            }
         }
     }
 
+    shape_groups::~shape_groups()
+    {
+        _clear();
+        delete[] _hdma_source_a;
+        delete[] _hdma_source_b;
+    }
+
     void shape_groups::load_colors(const bn::span<const bn::color> &colors)
     {
         int colors_count = colors.size();
@@ -238,42 +259,60 @@ namespace fr
 
     void shape_groups::update()
     {
-        if (_draw_enabled)
+        if (_draw_enabled && _max_hdma_sprites)
         {
             uint16_t *hdma_source = _hdma_source;
+            int hlines_count = 0;
+            int peak_hlines_count = 0;
             _draw_enabled = false;
 
-            if (hdma_source == _hdma_source_a)
+            for (int y = 0; y < bn::display::height(); ++y)
             {
-                _hide_left_hlines(_previous_hlines_count_a);
-            }
-            else
-            {
-                _hide_left_hlines(_previous_hlines_count_b);
+                int line_hlines_count = _hlines_count[y];
+                hlines_count += line_hlines_count;
+                peak_hlines_count = bn::max(peak_hlines_count, line_hlines_count);
             }
 
-            int max_sprites = _max_hdma_sprites;
+            // HDMA only writes as many sprites per screen line as the busiest line needs, always starting at the
+            // same OAM index. The last transfer of last frame (screen line 0) hid all sprites above its peak,
+            // so sprites left out since then stay hidden:
+            int max_sprites = bn::max(bn::max(peak_hlines_count, _last_peak_hlines_count), 1);
+            _pack_hlines(max_sprites);
+            _last_hlines_count = hlines_count;
+            _last_peak_hlines_count = peak_hlines_count;
+            _last_hdma_sprites_count = max_sprites;
+
             int screen_line_elements = max_sprites * 4;
             bn::memory::copy(hdma_source[0], screen_line_elements,
                              hdma_source[bn::display::height() * screen_line_elements]);
             bn::hdma::start(hdma_source[screen_line_elements], screen_line_elements,
-                            bn::hw::sprites::vram()[128 - max_sprites].attr0);
+                            bn::hw::sprites::vram()[128 - _max_hdma_sprites].attr0);
 
             if (hdma_source == _hdma_source_a)
             {
-                bn::memory::copy(*_hlines_count, bn::display::height(), *_previous_hlines_count_a);
                 _hdma_source = _hdma_source_b;
             }
             else
             {
-                bn::memory::copy(*_hlines_count, bn::display::height(), *_previous_hlines_count_b);
                 _hdma_source = _hdma_source_a;
             }
 
             bn::memory::clear(bn::display::height(), *_hlines_count);
+            bn::memory::clear(bn::display::height(), *_last_hlines);
+
+            #if FR_COVERAGE_BUFFER
+                for (coverage_line &coverage_line : _coverage_lines)
+                {
+                    coverage_line.count = 0;
+                }
+            #endif
         }
         else
         {
+            _last_hlines_count = 0;
+            _last_hdma_sprites_count = 0;
+            _last_peak_hlines_count = _max_hdma_sprites;
+            _draw_enabled = false;
             _clear();
         }
     }
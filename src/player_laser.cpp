@@ -367,6 +367,7 @@ int player_laser::render_player_laser(
                              7);
         laser_faces[3].reset(laser_vertices, fr::vertex_3d(0, 1, 0), 3, 5, 4, 0,
                              7);
+        laser_full.update_bounding_sphere();
         // laser_faces[4].reset(laser_vertices, fr::vertex_3d(0, 1, 0), 0, 2, 5, 0,
         //                      7);
         // laser_faces[5].reset(laser_vertices, fr::vertex_3d(0, 1, 0), 0, 5, 2, 0,
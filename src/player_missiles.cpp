@@ -136,6 +136,7 @@ int missile::statics_render(const fr::model_3d_item **static_model_items, int st
                            7);
     missile_faces[3].reset(missile_vertices, fr::vertex_3d(0, 1, 0), 2, 4, 3, 0,
                            7);
+    missile_full.update_bounding_sphere();
 
     // Add nem mesh as static object
     if (static_count >= fr::constants_3d::max_static_models)
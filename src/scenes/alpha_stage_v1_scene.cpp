@@ -48,7 +48,7 @@ const int start_position = 1900;
 #endif
 
 alpha_stage_v1_scene::alpha_stage_v1_scene()
-    : _base_game_scene(scene_colors, get_scene_color_mapping(), sections, sections_count, start_position), // <-- MAGIC NUMBER
+    : _base_game_scene(scene_colors, get_scene_color_mapping(), sections, sections_count, stage_events, start_position), // <-- MAGIC NUMBER
     //   _enemy_manager(&_models, &_controller),
       _prepare_to_leave(false),
       _letterbox_manager(),
@@ -0,0 +1,23 @@
+#include "stage_event_cursor.h"
+
+const stage_event *stage_event_cursor::next(
+    const bn::span<const stage_event> &events, stage_section_list_ptr sections,
+    bn::fixed camera_y)
+{
+    while (_next_event_index < events.size() &&
+           camera_y <= events[_next_event_index].position)
+    {
+        const stage_event &event = events[_next_event_index];
+        ++_next_event_index;
+
+        if (event.type == stage_event_type::SPAWN &&
+            camera_y <= sections[event.section_index]->ending_pos())
+        {
+            continue;
+        }
+
+        return &event;
+    }
+
+    return nullptr;
+}
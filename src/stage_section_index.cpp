@@ -0,0 +1,185 @@
+#include "stage_section_index.h"
+
+#include "bn_algorithm.h"
+#include "bn_assert.h"
+
+stage_section_index::stage_section_index(stage_section_list_ptr sections,
+                                         size_t sections_count)
+{
+    BN_ASSERT(int(sections_count) <= max_sections,
+              "Too many sections: ", sections_count, " - ", max_sections);
+
+    // Stable insertion sorts, sections are usually already in order:
+    for (size_t section_iter = 0; section_iter < sections_count;
+         section_iter++)
+    {
+        const stage_section *section = sections[section_iter];
+        int start_index = _sections_by_start.size();
+        int end_index = _sections_by_end.size();
+        _sections_by_start.push_back(section);
+        _sections_by_end.push_back(section);
+
+        while (start_index > 0 &&
+               _sections_by_start[start_index - 1]->starting_pos() <
+                   section->starting_pos())
+        {
+            _sections_by_start[start_index] =
+                _sections_by_start[start_index - 1];
+            --start_index;
+        }
+
+        _sections_by_start[start_index] = section;
+
+        while (end_index > 0 && _sections_by_end[end_index - 1]->ending_pos() <
+                                    section->ending_pos())
+        {
+            _sections_by_end[end_index] = _sections_by_end[end_index - 1];
+            --end_index;
+        }
+
+        _sections_by_end[end_index] = section;
+    }
+
+    // Sections the camera is in at the start of each section. The camera
+    // can't be in more sections at once than at some start:
+    int max_active_count = 0;
+    int passed_count = 0;
+    int sections_by_start_count = _sections_by_start.size();
+
+    for (int index = 0; index < sections_by_start_count; ++index)
+    {
+        int camera_position = _sections_by_start[index]->starting_pos();
+        int entered_count = index + 1;
+
+        while (entered_count < sections_by_start_count &&
+               _sections_by_start[entered_count]->starting_pos() >=
+                   camera_position)
+        {
+            ++entered_count;
+        }
+
+        while (passed_count < sections_by_start_count &&
+               _sections_by_end[passed_count]->ending_pos() >= camera_position)
+        {
+            ++passed_count;
+        }
+
+        max_active_count =
+            bn::max(max_active_count, entered_count - passed_count);
+    }
+
+    BN_ASSERT(max_active_count <= max_active_sections,
+              "Too many overlapping sections: ", max_active_count, " - ",
+              max_active_sections);
+}
+
+bool stage_section_index::update(bn::fixed camera_position)
+{
+    int entered_count = _entered_count;
+    int passed_count = _passed_count;
+    int sections_count = _sections_by_start.size();
+
+    while (entered_count < sections_count &&
+           camera_position <= _sections_by_start[entered_count]->starting_pos())
+    {
+        ++entered_count;
+    }
+
+    while (entered_count > 0 &&
+           camera_position > _sections_by_start[entered_count - 1]->starting_pos())
+    {
+        --entered_count;
+    }
+
+    while (passed_count < sections_count &&
+           camera_position <= _sections_by_end[passed_count]->ending_pos())
+    {
+        ++passed_count;
+    }
+
+    while (passed_count > 0 &&
+           camera_position > _sections_by_end[passed_count - 1]->ending_pos())
+    {
+        --passed_count;
+    }
+
+    if (entered_count == _entered_count && passed_count == _passed_count)
+    {
+        return false;
+    }
+
+    // Only the sections which have been entered, left, passed or unpassed can
+    // change their active state. They're removed first, so the active
+    // sections always fit:
+    int first_entered_index = bn::min(entered_count, _entered_count);
+    int last_entered_index = bn::max(entered_count, _entered_count);
+    int first_passed_index = bn::min(passed_count, _passed_count);
+    int last_passed_index = bn::max(passed_count, _passed_count);
+
+    for (int index = first_entered_index; index < last_entered_index; ++index)
+    {
+        _remove_active_section(_sections_by_start[index]);
+    }
+
+    for (int index = first_passed_index; index < last_passed_index; ++index)
+    {
+        _remove_active_section(_sections_by_end[index]);
+    }
+
+    for (int index = first_entered_index; index < last_entered_index; ++index)
+    {
+        _add_active_section(_sections_by_start[index], camera_position);
+    }
+
+    for (int index = first_passed_index; index < last_passed_index; ++index)
+    {
+        _add_active_section(_sections_by_end[index], camera_position);
+    }
+
+    _entered_count = entered_count;
+    _passed_count = passed_count;
+    return true;
+}
+
+void stage_section_index::_remove_active_section(const stage_section *section)
+{
+    auto active_it = _active_sections.begin();
+    auto active_end = _active_sections.end();
+
+    while (active_it != active_end && *active_it != section)
+    {
+        ++active_it;
+    }
+
+    if (active_it != active_end)
+    {
+        _active_sections.erase(active_it);
+    }
+}
+
+void stage_section_index::_add_active_section(const stage_section *section,
+                                              bn::fixed camera_position)
+{
+    if (camera_position > section->starting_pos() ||
+        camera_position <= section->ending_pos())
+    {
+        return;
+    }
+
+    auto active_it = _active_sections.begin();
+    auto active_end = _active_sections.end();
+
+    while (active_it != active_end &&
+           (*active_it)->starting_pos() >= section->starting_pos())
+    {
+        // Sections can be in both the entered and passed ranges:
+        if (*active_it == section)
+        {
+            return;
+        }
+
+        ++active_it;
+    }
+
+    _active_sections.insert(active_it, section);
+}
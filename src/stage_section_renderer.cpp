@@ -27,80 +27,56 @@ void stage_section_renderer::render_single_section(
 }
 
 int stage_section_renderer::render_sections(
-    const bn::fixed camera_position, stage_section_list_ptr sections,
-    size_t sections_count, const fr::model_3d_item **static_model_items)
+    const stage_section_index &section_index,
+    const fr::model_3d_item **static_model_items)
 {
     int current_model = 0;
 
-    // Iterate through sections.
-    for (size_t section_iter = 0; section_iter < sections_count; section_iter++)
+    // Iterate through active sections.
+    for (const stage_section *current_section :
+         section_index.active_sections())
     {
-        const stage_section *current_section = sections[section_iter];
-        // Check if we should render section.
-        if (camera_position <= current_section->starting_pos() &&
-            camera_position > current_section->ending_pos())
+        // Render section's models.
+        for (int i = 0; i < current_section->static_model_count(); i++)
         {
-            // Render section's models.
-            for (int i = 0; i < current_section->static_model_count(); i++)
+            // Check if we're rendering more models than we can!
+            if (current_model >= fr::constants_3d::max_static_models)
             {
-                // Check if we're rendering more models than we can!
-                if (current_model >= fr::constants_3d::max_static_models)
-                {
-                    BN_LOG(
-                        "Stage Section Renderer: reached static model max "
-                        "limit: " +
-                        bn::to_string<64>(fr::constants_3d::max_static_models));
-                    return current_model;
-                }
-                static_model_items[current_model] =
-                    &current_section->static_model_items()[i];
-                current_model++;
+                BN_LOG("Stage Section Renderer: reached static model max "
+                       "limit: " +
+                       bn::to_string<64>(fr::constants_3d::max_static_models));
+                return current_model;
             }
+            static_model_items[current_model] =
+                &current_section->static_model_items()[i];
+            current_model++;
         }
     }
 
     return current_model;
 }
 
-int stage_section_renderer::manage_section_render(
-    stage_section_list_ptr sections, size_t sections_count,
-    fr::camera_3d &camera, const fr::model_3d_item **static_model_items)
-{
-
-    // <-- Let's not pass this entire camera, just its Y position
-    const bn::fixed camera_position = camera.position().y();
-    // BN_LOG("CAMERA POS: " + bn::to_string<32>(camera_position));
-
-    return stage_section_renderer::render_sections(
-        camera_position, sections, sections_count, static_model_items);
-}
-
 int stage_section_renderer::collect_section_colliders(
-    stage_section_list_ptr sections, size_t sections_count,
-    bn::fixed camera_position,
+    const stage_section_index &section_index,
     sphere_collider *out_colliders, int max_colliders)
 {
     int current = 0;
 
-    for (size_t section_iter = 0; section_iter < sections_count; section_iter++)
+    for (const stage_section *current_section :
+         section_index.active_sections())
     {
-        const stage_section *current_section = sections[section_iter];
-        if (camera_position <= current_section->starting_pos() &&
-            camera_position > current_section->ending_pos())
-        {
-            int col_count = current_section->static_collider_count();
-            const sphere_collider *col_data = current_section->static_colliders();
+        int col_count = current_section->static_collider_count();
+        const sphere_collider *col_data = current_section->static_colliders();
 
-            for (int i = 0; i < col_count; i++)
+        for (int i = 0; i < col_count; i++)
+        {
+            if (current >= max_colliders)
             {
-                if (current >= max_colliders)
-                {
-                    BN_LOG("Stage Section Renderer: reached static collider max limit");
-                    return current;
-                }
-                out_colliders[current] = col_data[i];
-                current++;
+                BN_LOG("Stage Section Renderer: reached static collider max limit");
+                return current;
             }
+            out_colliders[current] = col_data[i];
+            current++;
         }
     }
 
@@ -0,0 +1,739 @@
+/*
+ * Interpreter of the ARM mode (ARMv4) instructions used by the hand written
+ * kernels of fr_lib.
+ */
+
+#include "arm_interpreter.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace arm_interpreter
+{
+namespace
+{
+// Functions return to this address, which is never executed:
+constexpr uint32_t return_address = 0xFFFFFFF0;
+
+[[nodiscard]] uint32_t rotate_right(uint32_t value, int amount)
+{
+    amount &= 31;
+    return amount ? (value >> amount) | (value << (32 - amount)) : value;
+}
+
+[[nodiscard]] std::string hex(uint32_t value)
+{
+    char result[16];
+    std::snprintf(result, sizeof(result), "0x%08X", value);
+    return result;
+}
+} // namespace
+
+cpu::cpu(uint32_t base_address, int size)
+    : _base_address(base_address), _memory(size_t(size))
+{
+}
+
+uint8_t *cpu::host_pointer(uint32_t address, int size)
+{
+    return _valid(address, size) ? _memory.data() + (address - _base_address)
+                                 : nullptr;
+}
+
+void cpu::write(uint32_t address, const void *data, int size)
+{
+    if (uint8_t *pointer = host_pointer(address, size))
+    {
+        std::memcpy(pointer, data, size_t(size));
+    }
+}
+
+void cpu::read(uint32_t address, void *data, int size) const
+{
+    if (_valid(address, size))
+    {
+        std::memcpy(data, _memory.data() + (address - _base_address),
+                    size_t(size));
+    }
+}
+
+bool cpu::call(uint32_t address, const uint32_t (&arguments)[4],
+               uint32_t stack_address, int max_instructions)
+{
+    std::memset(_regs, 0, sizeof(_regs));
+    std::memcpy(_regs, arguments, sizeof(arguments));
+    _regs[13] = stack_address;
+    _regs[14] = return_address;
+    _regs[15] = address;
+    _cycles = 0;
+    _error.clear();
+
+    for (int instructions = 0; instructions < max_instructions;
+         ++instructions)
+    {
+        if (_regs[15] == return_address)
+        {
+            return true;
+        }
+
+        if (!_step())
+        {
+            return false;
+        }
+    }
+
+    return _fail("too many instructions");
+}
+
+bool cpu::_valid(uint32_t address, int size) const
+{
+    return address >= _base_address &&
+           address - _base_address <= _memory.size() - size_t(size);
+}
+
+uint32_t cpu::_load(uint32_t address, int size)
+{
+    if (!_valid(address, size) || address % uint32_t(size))
+    {
+        (void)_fail("invalid load from " + hex(address));
+        return 0;
+    }
+
+    uint32_t result = 0;
+    std::memcpy(&result, _memory.data() + (address - _base_address),
+                size_t(size));
+    return result;
+}
+
+void cpu::_store(uint32_t address, uint32_t value, int size)
+{
+    if (!_valid(address, size) || address % uint32_t(size))
+    {
+        (void)_fail("invalid store to " + hex(address));
+        return;
+    }
+
+    std::memcpy(_memory.data() + (address - _base_address), &value,
+                size_t(size));
+}
+
+uint32_t cpu::_read_reg(int index) const
+{
+    return index == 15 ? _regs[15] + 8 : _regs[index];
+}
+
+void cpu::_write_reg(int index, uint32_t value)
+{
+    if (index == 15)
+    {
+        value &= ~3u;
+        _branched = true;
+    }
+
+    _regs[index] = value;
+}
+
+bool cpu::_condition(uint32_t instruction) const
+{
+    switch (instruction >> 28)
+    {
+    case 0x0:
+        return _z;
+    case 0x1:
+        return !_z;
+    case 0x2:
+        return _c;
+    case 0x3:
+        return !_c;
+    case 0x4:
+        return _n;
+    case 0x5:
+        return !_n;
+    case 0x6:
+        return _v;
+    case 0x7:
+        return !_v;
+    case 0x8:
+        return _c && !_z;
+    case 0x9:
+        return !_c || _z;
+    case 0xA:
+        return _n == _v;
+    case 0xB:
+        return _n != _v;
+    case 0xC:
+        return !_z && _n == _v;
+    case 0xD:
+        return _z || _n != _v;
+    default:
+        return true;
+    }
+}
+
+uint32_t cpu::_shifted_register(uint32_t instruction, bool &carry) const
+{
+    uint32_t value = _read_reg(int(instruction & 0xF));
+    int type = int((instruction >> 5) & 3);
+    int amount;
+    carry = _c;
+
+    if (instruction & 0x10)
+    {
+        amount = int(_read_reg(int((instruction >> 8) & 0xF)) & 0xFF);
+
+        if (!amount)
+        {
+            return value;
+        }
+    }
+    else
+    {
+        amount = int((instruction >> 7) & 0x1F);
+
+        if (!amount)
+        {
+            switch (type)
+            {
+            case 0: // LSL #0
+                return value;
+            case 1: // LSR #32
+                carry = value >> 31;
+                return 0;
+            case 2: // ASR #32
+                carry = value >> 31;
+                return carry ? 0xFFFFFFFF : 0;
+            default: // RRX
+            {
+                bool old_carry = _c;
+                carry = value & 1;
+                return (value >> 1) | (uint32_t(old_carry) << 31);
+            }
+            }
+        }
+    }
+
+    switch (type)
+    {
+    case 0:
+        carry = amount <= 32 && ((value >> (32 - amount)) & 1);
+        return amount < 32 ? value << amount : 0;
+    case 1:
+        carry = amount <= 32 && ((value >> (amount - 1)) & 1);
+        return amount < 32 ? value >> amount : 0;
+    case 2:
+        if (amount >= 32)
+        {
+            carry = value >> 31;
+            return carry ? 0xFFFFFFFF : 0;
+        }
+
+        carry = (value >> (amount - 1)) & 1;
+        return uint32_t(int32_t(value) >> amount);
+    default:
+        carry = (value >> ((amount - 1) & 31)) & 1;
+        return rotate_right(value, amount);
+    }
+}
+
+int cpu::_instruction_cycles(uint32_t instruction) const
+{
+    // Sequential, non sequential and internal cycles all take one cycle
+    // without wait states. Writing the pc refills the pipeline (+2):
+    if ((instruction & 0x0FFFFFF0) == 0x012FFF10 ||
+        (instruction & 0x0E000000) == 0x0A000000)
+    {
+        // BX, B, BL:
+        return 3;
+    }
+
+    if ((instruction & 0x0FC000F0) == 0x00000090)
+    {
+        // MUL, MLA. The multiplier stops early if the top bits of rs are all
+        // zeros or all ones:
+        uint32_t rs = _read_reg(int((instruction >> 8) & 0xF));
+        int cycles = (instruction & 0x00200000) ? 2 : 1;
+
+        for (int shift = 8; shift < 32; shift += 8)
+        {
+            uint32_t top_bits = rs >> shift;
+
+            if (!top_bits || top_bits == (0xFFFFFFFF >> shift))
+            {
+                return cycles + (shift / 8);
+            }
+        }
+
+        return cycles + 4;
+    }
+
+    bool load = instruction & 0x00100000;
+    int rd = int((instruction >> 12) & 0xF);
+
+    if ((instruction & 0x0E000090) == 0x00000090 && (instruction & 0x60))
+    {
+        // LDRH, LDRSB, LDRSH, STRH:
+        return load ? (rd == 15 ? 5 : 3) : 2;
+    }
+
+    if ((instruction & 0x0C000000) == 0)
+    {
+        // Data processing, register specified shifts take one more cycle:
+        int cycles = (instruction & 0x02000010) == 0x00000010 ? 2 : 1;
+        int opcode = int((instruction >> 21) & 0xF);
+        bool test = opcode >= 0x8 && opcode <= 0xB;
+        return rd == 15 && !test ? cycles + 2 : cycles;
+    }
+
+    if ((instruction & 0x0C000000) == 0x04000000)
+    {
+        // LDR, STR:
+        return load ? (rd == 15 ? 5 : 3) : 2;
+    }
+
+    // LDM, STM:
+    int count = 0;
+
+    for (uint32_t list = instruction & 0xFFFF; list; list &= list - 1)
+    {
+        ++count;
+    }
+
+    if (load)
+    {
+        return (instruction & 0x8000) ? count + 4 : count + 2;
+    }
+
+    return count + 1;
+}
+
+bool cpu::_step()
+{
+    uint32_t pc = _regs[15];
+    uint32_t instruction = _load(pc, 4);
+
+    if (!_error.empty())
+    {
+        return false;
+    }
+
+    _branched = false;
+
+    if (_condition(instruction))
+    {
+        _cycles += _instruction_cycles(instruction);
+
+        bool result;
+
+        if ((instruction & 0x0FFFFFF0) == 0x012FFF10)
+        {
+            // BX (Thumb is not supported):
+            uint32_t target = _read_reg(int(instruction & 0xF));
+
+            if (target & 1)
+            {
+                return _fail("Thumb mode at " + hex(pc));
+            }
+
+            _write_reg(15, target);
+            result = true;
+        }
+        else if ((instruction & 0x0FC000F0) == 0x00000090)
+        {
+            result = _multiply(instruction);
+        }
+        else if ((instruction & 0x0E000090) == 0x00000090 &&
+                 (instruction & 0x60))
+        {
+            result = _halfword_transfer(instruction);
+        }
+        else if ((instruction & 0x0C000000) == 0)
+        {
+            result = _data_processing(instruction);
+        }
+        else if ((instruction & 0x0C000000) == 0x04000000)
+        {
+            result = _single_transfer(instruction);
+        }
+        else if ((instruction & 0x0E000000) == 0x08000000)
+        {
+            result = _block_transfer(instruction);
+        }
+        else if ((instruction & 0x0E000000) == 0x0A000000)
+        {
+            // B, BL:
+            int32_t offset = int32_t(instruction << 8) >> 6;
+
+            if (instruction & 0x01000000)
+            {
+                _regs[14] = pc + 4;
+            }
+
+            _write_reg(15, pc + 8 + uint32_t(offset));
+            result = true;
+        }
+        else
+        {
+            result = false;
+        }
+
+        if (!result)
+        {
+            if (_error.empty())
+            {
+                (void)_fail("unsupported instruction " + hex(instruction) + " at " +
+                      hex(pc));
+            }
+
+            return false;
+        }
+
+        if (!_error.empty())
+        {
+            return false;
+        }
+    }
+    else
+    {
+        ++_cycles;
+    }
+
+    if (!_branched)
+    {
+        _regs[15] = pc + 4;
+    }
+
+    return true;
+}
+
+bool cpu::_data_processing(uint32_t instruction)
+{
+    int opcode = int((instruction >> 21) & 0xF);
+    bool set_flags = instruction & 0x00100000;
+    int rn = int((instruction >> 16) & 0xF);
+    int rd = int((instruction >> 12) & 0xF);
+    bool shifter_carry;
+    uint32_t operand;
+
+    if (instruction & 0x02000000)
+    {
+        int rotation = int((instruction >> 8) & 0xF) * 2;
+        operand = rotate_right(instruction & 0xFF, rotation);
+        shifter_carry = rotation ? operand >> 31 : _c;
+    }
+    else
+    {
+        operand = _shifted_register(instruction, shifter_carry);
+    }
+
+    uint32_t first = _read_reg(rn);
+    uint64_t wide_result = 0;
+    uint32_t result;
+    bool arithmetic = true;
+    bool overflow = false;
+
+    auto add = [&](uint32_t a, uint32_t b, uint32_t carry) {
+        wide_result = uint64_t(a) + b + carry;
+        uint32_t sum = uint32_t(wide_result);
+        overflow = ((a ^ sum) & (b ^ sum)) >> 31;
+        return sum;
+    };
+
+    switch (opcode)
+    {
+    case 0x0: // AND
+    case 0x8: // TST
+        result = first & operand;
+        arithmetic = false;
+        break;
+    case 0x1: // EOR
+    case 0x9: // TEQ
+        result = first ^ operand;
+        arithmetic = false;
+        break;
+    case 0x2: // SUB
+    case 0xA: // CMP
+        result = add(first, ~operand, 1);
+        break;
+    case 0x3: // RSB
+        result = add(operand, ~first, 1);
+        break;
+    case 0x4: // ADD
+    case 0xB: // CMN
+        result = add(first, operand, 0);
+        break;
+    case 0x5: // ADC
+        result = add(first, operand, _c);
+        break;
+    case 0x6: // SBC
+        result = add(first, ~operand, _c);
+        break;
+    case 0x7: // RSC
+        result = add(operand, ~first, _c);
+        break;
+    case 0xC: // ORR
+        result = first | operand;
+        arithmetic = false;
+        break;
+    case 0xD: // MOV
+        result = operand;
+        arithmetic = false;
+        break;
+    case 0xE: // BIC
+        result = first & ~operand;
+        arithmetic = false;
+        break;
+    default: // MVN
+        result = ~operand;
+        arithmetic = false;
+        break;
+    }
+
+    bool test = opcode >= 0x8 && opcode <= 0xB;
+
+    if (test && !set_flags)
+    {
+        // MRS, MSR:
+        return false;
+    }
+
+    if (set_flags)
+    {
+        if (rd == 15 && !test)
+        {
+            // Exception return:
+            return false;
+        }
+
+        _n = result >> 31;
+        _z = !result;
+
+        if (arithmetic)
+        {
+            _c = wide_result >> 32;
+            _v = overflow;
+        }
+        else
+        {
+            _c = shifter_carry;
+        }
+    }
+
+    if (!test)
+    {
+        _write_reg(rd, result);
+    }
+
+    return true;
+}
+
+bool cpu::_multiply(uint32_t instruction)
+{
+    int rd = int((instruction >> 16) & 0xF);
+    int rn = int((instruction >> 12) & 0xF);
+    int rs = int((instruction >> 8) & 0xF);
+    int rm = int(instruction & 0xF);
+    uint32_t result = _read_reg(rm) * _read_reg(rs);
+
+    if (instruction & 0x00200000)
+    {
+        result += _read_reg(rn);
+    }
+
+    if (instruction & 0x00100000)
+    {
+        _n = result >> 31;
+        _z = !result;
+    }
+
+    _write_reg(rd, result);
+    return true;
+}
+
+bool cpu::_single_transfer(uint32_t instruction)
+{
+    bool pre_index = instruction & 0x01000000;
+    bool up = instruction & 0x00800000;
+    bool byte = instruction & 0x00400000;
+    bool write_back = instruction & 0x00200000;
+    bool load = instruction & 0x00100000;
+    int rn = int((instruction >> 16) & 0xF);
+    int rd = int((instruction >> 12) & 0xF);
+    uint32_t offset;
+
+    if (instruction & 0x02000000)
+    {
+        if (instruction & 0x10)
+        {
+            return false;
+        }
+
+        bool carry;
+        offset = _shifted_register(instruction, carry);
+    }
+    else
+    {
+        offset = instruction & 0xFFF;
+    }
+
+    uint32_t base = _read_reg(rn);
+    uint32_t offset_base = up ? base + offset : base - offset;
+    uint32_t address = pre_index ? offset_base : base;
+    int size = byte ? 1 : 4;
+
+    if (load)
+    {
+        uint32_t value = _load(address, size);
+
+        if (!pre_index || write_back)
+        {
+            _write_reg(rn, offset_base);
+        }
+
+        _write_reg(rd, value);
+    }
+    else
+    {
+        _store(address, rd == 15 ? _regs[15] + 12 : _read_reg(rd), size);
+
+        if (!pre_index || write_back)
+        {
+            _write_reg(rn, offset_base);
+        }
+    }
+
+    return true;
+}
+
+bool cpu::_halfword_transfer(uint32_t instruction)
+{
+    bool pre_index = instruction & 0x01000000;
+    bool up = instruction & 0x00800000;
+    bool write_back = instruction & 0x00200000;
+    bool load = instruction & 0x00100000;
+    int rn = int((instruction >> 16) & 0xF);
+    int rd = int((instruction >> 12) & 0xF);
+    int type = int((instruction >> 5) & 3);
+    uint32_t offset;
+
+    if (instruction & 0x00400000)
+    {
+        offset = ((instruction >> 4) & 0xF0) | (instruction & 0xF);
+    }
+    else
+    {
+        offset = _read_reg(int(instruction & 0xF));
+    }
+
+    uint32_t base = _read_reg(rn);
+    uint32_t offset_base = up ? base + offset : base - offset;
+    uint32_t address = pre_index ? offset_base : base;
+
+    if (load)
+    {
+        uint32_t value;
+
+        if (type == 1)
+        {
+            value = _load(address, 2);
+        }
+        else if (type == 2)
+        {
+            value = uint32_t(int32_t(int8_t(_load(address, 1))));
+        }
+        else
+        {
+            value = uint32_t(int32_t(int16_t(_load(address, 2))));
+        }
+
+        if (!pre_index || write_back)
+        {
+            _write_reg(rn, offset_base);
+        }
+
+        _write_reg(rd, value);
+    }
+    else
+    {
+        if (type != 1)
+        {
+            return false;
+        }
+
+        _store(address, _read_reg(rd), 2);
+
+        if (!pre_index || write_back)
+        {
+            _write_reg(rn, offset_base);
+        }
+    }
+
+    return true;
+}
+
+bool cpu::_block_transfer(uint32_t instruction)
+{
+    bool pre_index = instruction & 0x01000000;
+    bool up = instruction & 0x00800000;
+    bool write_back = instruction & 0x00200000;
+    bool load = instruction & 0x00100000;
+    int rn = int((instruction >> 16) & 0xF);
+    uint32_t registers = instruction & 0xFFFF;
+
+    if ((instruction & 0x00400000) || !registers)
+    {
+        // User bank transfers and empty lists:
+        return false;
+    }
+
+    uint32_t count = 0;
+
+    for (uint32_t list = registers; list; list &= list - 1)
+    {
+        ++count;
+    }
+
+    uint32_t base = _read_reg(rn);
+    uint32_t lowest_address = up ? base : base - (count * 4);
+
+    if (pre_index == up)
+    {
+        lowest_address += 4;
+    }
+
+    uint32_t final_base = up ? base + (count * 4) : base - (count * 4);
+    uint32_t address = lowest_address;
+
+    if (write_back && !(load && (registers & (1u << rn))))
+    {
+        _write_reg(rn, final_base);
+    }
+
+    for (int index = 0; index < 16; ++index)
+    {
+        if (registers & (1u << index))
+        {
+            if (load)
+            {
+                _write_reg(index, _load(address, 4));
+            }
+            else
+            {
+                uint32_t value = index == rn && write_back ? base
+                                 : index == 15 ? _regs[15] + 12
+                                               : _regs[index];
+                _store(address, value, 4);
+            }
+
+            address += 4;
+        }
+    }
+
+    return true;
+}
+
+bool cpu::_fail(const std::string &error)
+{
+    _error = error;
+    return false;
+}
+} // namespace arm_interpreter
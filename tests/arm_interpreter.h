@@ -0,0 +1,105 @@
+/*
+ * Interpreter of the ARM mode (ARMv4) instructions used by the hand written
+ * kernels of fr_lib, so they can be run on the host.
+ *
+ * Thumb mode, coprocessors, swaps, long multiplies, status register
+ * transfers and exceptions are not supported.
+ */
+
+#ifndef ARM_INTERPRETER_H
+#define ARM_INTERPRETER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arm_interpreter
+{
+class cpu
+{
+  public:
+    // Emulated memory is a single block of size bytes which starts at
+    // base_address:
+    cpu(uint32_t base_address, int size);
+
+    [[nodiscard]] uint32_t base_address() const
+    {
+        return _base_address;
+    }
+
+    [[nodiscard]] uint8_t *host_pointer(uint32_t address, int size);
+
+    void write(uint32_t address, const void *data, int size);
+
+    void read(uint32_t address, void *data, int size) const;
+
+    // Calls the function at the given address with the AAPCS arguments r0-r3
+    // and the stack pointer at stack_address. Returns false if it doesn't
+    // return in max_instructions or if it runs an unsupported instruction:
+    [[nodiscard]] bool call(uint32_t address, const uint32_t (&arguments)[4],
+                            uint32_t stack_address, int max_instructions);
+
+    [[nodiscard]] uint32_t reg(int index) const
+    {
+        return _regs[index];
+    }
+
+    // ARM7TDMI cycles of the last call(), with zero wait state memory like
+    // the GBA IWRAM:
+    [[nodiscard]] int cycles() const
+    {
+        return _cycles;
+    }
+
+    // Why the last call() failed:
+    [[nodiscard]] const std::string &error() const
+    {
+        return _error;
+    }
+
+  private:
+    uint32_t _base_address;
+    std::vector<uint8_t> _memory;
+    uint32_t _regs[16] = {};
+    bool _n = false;
+    bool _z = false;
+    bool _c = false;
+    bool _v = false;
+    bool _branched = false;
+    int _cycles = 0;
+    std::string _error;
+
+    [[nodiscard]] bool _valid(uint32_t address, int size) const;
+
+    [[nodiscard]] uint32_t _load(uint32_t address, int size);
+
+    void _store(uint32_t address, uint32_t value, int size);
+
+    [[nodiscard]] uint32_t _read_reg(int index) const;
+
+    void _write_reg(int index, uint32_t value);
+
+    [[nodiscard]] bool _condition(uint32_t instruction) const;
+
+    [[nodiscard]] uint32_t _shifted_register(uint32_t instruction,
+                                             bool &carry) const;
+
+    [[nodiscard]] int _instruction_cycles(uint32_t instruction) const;
+
+    [[nodiscard]] bool _step();
+
+    [[nodiscard]] bool _data_processing(uint32_t instruction);
+
+    [[nodiscard]] bool _multiply(uint32_t instruction);
+
+    [[nodiscard]] bool _single_transfer(uint32_t instruction);
+
+    [[nodiscard]] bool _halfword_transfer(uint32_t instruction);
+
+    [[nodiscard]] bool _block_transfer(uint32_t instruction);
+
+    [[nodiscard]] bool _fail(const std::string &error);
+};
+} // namespace arm_interpreter
+
+#endif
@@ -0,0 +1,203 @@
+/*
+ * Tests of the visible faces depth sort (fr_depth_sort.h).
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "fr_depth_sort.h"
+
+#include "host_test.h"
+
+namespace
+{
+constexpr int max_faces = FR_MAX_FACES;
+
+uint16_t bucket_offsets[fr::depth_sort::buckets];
+
+// Stable sort of the identity permutation, which is what the radix sort does:
+[[nodiscard]] std::vector<uint8_t> reference_order(
+    const std::vector<uint16_t> &keys)
+{
+    std::vector<uint8_t> result(keys.size());
+    std::iota(result.begin(), result.end(), 0);
+    std::stable_sort(result.begin(), result.end(),
+                     [&keys](uint8_t a, uint8_t b) { return keys[a] < keys[b]; });
+    return result;
+}
+
+[[nodiscard]] bool sorted_by_keys(const std::vector<uint16_t> &keys,
+                                  const std::vector<uint8_t> &indexes)
+{
+    return std::is_sorted(indexes.begin(), indexes.end(),
+                          [&keys](uint8_t a, uint8_t b) {
+                              return keys[a] < keys[b];
+                          });
+}
+
+[[nodiscard]] bool is_permutation(const std::vector<uint8_t> &indexes)
+{
+    std::vector<uint8_t> sorted_indexes = indexes;
+    std::sort(sorted_indexes.begin(), sorted_indexes.end());
+
+    for (int index = 0; index < int(sorted_indexes.size()); ++index)
+    {
+        if (sorted_indexes[index] != index)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+[[nodiscard]] std::vector<uint16_t> random_keys(std::mt19937 &random,
+                                                int count, int max_key)
+{
+    std::uniform_int_distribution<int> distribution(0, max_key);
+    std::vector<uint16_t> result(count);
+
+    for (uint16_t &key : result)
+    {
+        key = uint16_t(distribution(random));
+    }
+
+    return result;
+}
+} // namespace
+
+HOST_TEST(depth_key_puts_farthest_faces_first)
+{
+    CHECK(fr::depth_sort::key(4000) < fr::depth_sort::key(400));
+    CHECK(fr::depth_sort::key(400) < fr::depth_sort::key(40));
+    CHECK_EQUAL(fr::depth_sort::key(-40), fr::depth_sort::key_max);
+    CHECK_EQUAL(fr::depth_sort::key(1 << 20), 0);
+}
+
+HOST_TEST(radix_sort_matches_stable_sort)
+{
+    std::mt19937 random(1234);
+
+    for (int iteration = 0; iteration < 500; ++iteration)
+    {
+        int count = 1 + int(random() % max_faces);
+        int max_key = iteration % 3 ? fr::depth_sort::key_max : 16;
+        std::vector<uint16_t> keys = random_keys(random, count, max_key);
+        std::vector<uint8_t> expected_indexes = reference_order(keys);
+
+        std::vector<uint16_t> sorted_keys = keys;
+        std::vector<uint8_t> indexes(count);
+        std::iota(indexes.begin(), indexes.end(), 0);
+        std::vector<uint16_t> temp_keys(count);
+        std::vector<uint8_t> temp_indexes(count);
+        fr::depth_sort::radix_sort(sorted_keys.data(), indexes.data(),
+                                   temp_keys.data(), temp_indexes.data(),
+                                   bucket_offsets,
+                                   count);
+
+        CHECK(indexes == expected_indexes);
+        CHECK(std::is_sorted(sorted_keys.begin(), sorted_keys.end()));
+    }
+}
+
+HOST_TEST(radix_sort_skips_passes_with_equal_keys)
+{
+    std::vector<uint16_t> keys(40, 0x1234);
+    std::vector<uint8_t> indexes(40);
+    std::iota(indexes.begin(), indexes.end(), 0);
+    std::vector<uint8_t> expected_indexes = indexes;
+    std::vector<uint16_t> temp_keys(40);
+    std::vector<uint8_t> temp_indexes(40);
+    fr::depth_sort::radix_sort(keys.data(), indexes.data(), temp_keys.data(),
+                               temp_indexes.data(), bucket_offsets, 40);
+
+    CHECK(indexes == expected_indexes);
+}
+
+HOST_TEST(insertion_sort_matches_radix_sort_order)
+{
+    std::mt19937 random(5678);
+
+    for (int iteration = 0; iteration < 500; ++iteration)
+    {
+        int count = 1 + int(random() % max_faces);
+        std::vector<uint16_t> keys =
+            random_keys(random, count, fr::depth_sort::key_max);
+
+        // Previous frame order is a random permutation:
+        std::vector<uint8_t> indexes(count);
+        std::iota(indexes.begin(), indexes.end(), 0);
+        std::shuffle(indexes.begin(), indexes.end(), random);
+
+        bool sorted = fr::depth_sort::insertion_sort(
+            keys.data(), indexes.data(), count, count * count);
+
+        CHECK(sorted);
+        CHECK(is_permutation(indexes));
+        CHECK(sorted_by_keys(keys, indexes));
+    }
+}
+
+HOST_TEST(insertion_sort_gives_up_after_max_moves)
+{
+    std::vector<uint16_t> keys = {5, 4, 3, 2, 1, 0};
+    std::vector<uint8_t> indexes = {0, 1, 2, 3, 4, 5};
+
+    // Reversed order needs 15 moves:
+    CHECK(!fr::depth_sort::insertion_sort(keys.data(), indexes.data(), 6, 14));
+    CHECK(is_permutation(indexes));
+
+    indexes = {0, 1, 2, 3, 4, 5};
+    CHECK(fr::depth_sort::insertion_sort(keys.data(), indexes.data(), 6, 15));
+    CHECK(indexes == std::vector<uint8_t>({5, 4, 3, 2, 1, 0}));
+}
+
+HOST_TEST(resize_order_keeps_relative_order)
+{
+    std::vector<uint8_t> indexes = {4, 0, 5, 2, 1, 3};
+    fr::depth_sort::resize_order(indexes.data(), 6, 4);
+    indexes.resize(4);
+    CHECK(indexes == std::vector<uint8_t>({0, 2, 1, 3}));
+
+    indexes = {2, 0, 1, 0, 0, 0};
+    fr::depth_sort::resize_order(indexes.data(), 3, 6);
+    CHECK(indexes == std::vector<uint8_t>({2, 0, 1, 3, 4, 5}));
+}
+
+HOST_TEST(resized_order_is_repaired_with_few_moves)
+{
+    std::mt19937 random(91011);
+    int count = 120;
+
+    // Sorted keys, slightly moved and with some faces added at the end:
+    std::vector<uint16_t> keys = random_keys(random, count, 60000);
+    std::vector<uint8_t> indexes = reference_order(keys);
+
+    int new_count = count + 2;
+    keys.resize(new_count);
+
+    for (int index = 0; index < new_count; ++index)
+    {
+        if (index >= count)
+        {
+            keys[index] = uint16_t(random() % 60000);
+        }
+        else
+        {
+            keys[index] = uint16_t(keys[index] + random() % 8);
+        }
+    }
+
+    indexes.resize(new_count);
+    fr::depth_sort::resize_order(indexes.data(), count, new_count);
+
+    bool sorted = fr::depth_sort::insertion_sort(
+        keys.data(), indexes.data(), new_count,
+        new_count * FR_DEPTH_SORT_MAX_MOVES_PER_FACE);
+
+    CHECK(sorted);
+    CHECK(is_permutation(indexes));
+    CHECK(sorted_by_keys(keys, indexes));
+}
@@ -0,0 +1,226 @@
+/*
+ * Tests of fr::face_cluster_visibility against the per-face back-face test
+ * of models_3d, with the unit normals clusters are built from and with the
+ * 8.8 normals of packed faces.
+ */
+
+#include <random>
+#include <vector>
+
+#include "fr_face_cluster_visibility.h"
+#include "fr_sin_cos.h"
+
+#include "models/asteroid1.h"
+#include "models/big_asteroid_1.h"
+
+#include "host_test.h"
+
+namespace
+{
+// Per-face test of models_3d::_process_models:
+[[nodiscard]] bool face_visible(const fr::point_3d &centroid,
+                                const fr::point_3d &normal,
+                                const fr::point_3d &camera_position)
+{
+    return (centroid - camera_position).safe_dot_product(normal) < 0;
+}
+
+[[nodiscard]] fr::point_3d random_point(std::mt19937 &random, int range)
+{
+    std::uniform_int_distribution<int> distribution(-range * 4096,
+                                                    range * 4096);
+    return fr::point_3d(bn::fixed::from_data(distribution(random)),
+                        bn::fixed::from_data(distribution(random)),
+                        bn::fixed::from_data(distribution(random)));
+}
+
+class visibility_counters
+{
+  public:
+    int hidden = 0;
+    int visible = 0;
+    int partial = 0;
+};
+
+// Checks every cluster of the given faces from random camera positions.
+// Returns false at the first mismatch:
+[[nodiscard]] bool check_clusters(
+    const bn::span<const fr::face_3d> &faces,
+    const bn::span<const fr::face_cluster_3d> &clusters, std::mt19937 &random,
+    int camera_range, visibility_counters &counters)
+{
+    for (int camera_index = 0; camera_index < 200; ++camera_index)
+    {
+        fr::point_3d model_position = random_point(random, 256);
+        fr::point_3d camera_position =
+            model_position + random_point(random, camera_range);
+
+        for (const fr::face_cluster_3d &cluster : clusters)
+        {
+            fr::cluster_visibility visibility = fr::face_cluster_visibility(
+                cluster, model_position, camera_position);
+
+            if (visibility == fr::cluster_visibility::partial)
+            {
+                ++counters.partial;
+                continue;
+            }
+
+            bool expected = visibility == fr::cluster_visibility::visible;
+            ++(expected ? counters.visible : counters.hidden);
+
+            for (int index = cluster.first_face_index(),
+                     last = index + cluster.faces_count();
+                 index < last; ++index)
+            {
+                const fr::face_3d &face = faces[index];
+                fr::point_3d centroid =
+                    face.centroid().point() + model_position;
+                fr::point_3d normal = face.normal().point();
+                fr::point_3d packed_normal =
+                    fr::packed_normal_3d(normal).point();
+                CHECK_EQUAL(face_visible(centroid, normal, camera_position),
+                            expected);
+                CHECK_EQUAL(
+                    face_visible(centroid, packed_normal, camera_position),
+                    expected);
+
+                if (face_visible(centroid, normal, camera_position) !=
+                        expected ||
+                    face_visible(centroid, packed_normal, camera_position) !=
+                        expected)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+// Faces whose normals are at most max_angle (in fr::sin units) away from a
+// random axis, grouped in clusters of cluster_size faces:
+class random_clusters
+{
+  public:
+    random_clusters(std::mt19937 &random, int cluster_size, int max_angle)
+    {
+        std::uniform_int_distribution<int> angle(0, 65535);
+        std::uniform_int_distribution<int> spread(0, max_angle);
+
+        for (int cluster = 0; cluster < 8; ++cluster)
+        {
+            int axis_phi = angle(random);
+            int axis_theta = angle(random);
+            fr::point_3d center = random_point(random, 32);
+
+            for (int face = 0; face < cluster_size; ++face)
+            {
+                int phi = axis_phi + spread(random);
+                int theta = axis_theta + spread(random);
+                bn::fixed sin_theta = fr::sin(theta);
+                fr::vertex_3d normal(fr::cos(phi) * sin_theta,
+                                     fr::sin(phi) * sin_theta, fr::cos(theta));
+                int first_vertex_index = int(_vertices.size());
+
+                for (int vertex = 0; vertex < 3; ++vertex)
+                {
+                    _vertices.emplace_back(center + random_point(random, 8));
+                }
+
+                _vertex_indexes.push_back(first_vertex_index);
+                _normals.push_back(normal);
+            }
+
+            _clusters_faces_counts.push_back(cluster_size);
+        }
+
+        for (int index = 0, limit = int(_normals.size()); index < limit;
+             ++index)
+        {
+            int first_vertex_index = _vertex_indexes[size_t(index)];
+            _faces.emplace_back(_vertices, _normals[size_t(index)],
+                                first_vertex_index, first_vertex_index + 1,
+                                first_vertex_index + 2, 0, 0);
+        }
+
+        int first_face_index = 0;
+
+        for (int faces_count : _clusters_faces_counts)
+        {
+            _clusters.emplace_back(_faces, first_face_index, faces_count);
+            first_face_index += faces_count;
+        }
+    }
+
+    [[nodiscard]] bn::span<const fr::face_3d> faces() const
+    {
+        return _faces;
+    }
+
+    [[nodiscard]] bn::span<const fr::face_cluster_3d> clusters() const
+    {
+        return _clusters;
+    }
+
+  private:
+    std::vector<fr::vertex_3d> _vertices;
+    std::vector<fr::vertex_3d> _normals;
+    std::vector<int> _vertex_indexes;
+    std::vector<int> _clusters_faces_counts;
+    std::vector<fr::face_3d> _faces;
+    std::vector<fr::face_cluster_3d> _clusters;
+};
+} // namespace
+
+HOST_TEST(model_clusters_match_faces)
+{
+    std::mt19937 random(1234);
+    visibility_counters counters;
+
+    for (int camera_range : {16, 64, 512, 2048})
+    {
+        if (!check_clusters(fr::model_3d_items::asteroid1_faces_full,
+                            fr::model_3d_items::asteroid1_full_face_clusters
+                                .clusters(),
+                            random, camera_range, counters) ||
+            !check_clusters(fr::model_3d_items::big_asteroid_1_faces_full,
+                            fr::model_3d_items::big_asteroid_1_full_face_clusters
+                                .clusters(),
+                            random, camera_range, counters))
+        {
+            return;
+        }
+    }
+
+    // Both verdicts must be exercised:
+    CHECK(counters.hidden > 0);
+    CHECK(counters.visible > 0);
+}
+
+HOST_TEST(random_clusters_match_faces)
+{
+    std::mt19937 random(5678);
+    visibility_counters counters;
+
+    for (int max_angle : {0, 512, 2048, 8192})
+    {
+        for (int cluster_size : {1, 2, 6})
+        {
+            random_clusters clusters(random, cluster_size, max_angle);
+
+            for (int camera_range : {16, 64, 512, 2048})
+            {
+                if (!check_clusters(clusters.faces(), clusters.clusters(),
+                                    random, camera_range, counters))
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    CHECK(counters.hidden > 0);
+    CHECK(counters.visible > 0);
+}
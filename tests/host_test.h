@@ -0,0 +1,72 @@
+/*
+ * Minimal test runner of the host tests.
+ *
+ * Tests are defined with HOST_TEST and run by host_test_main.cpp. Failed
+ * checks print their location and make the test program return an error.
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+namespace host_test
+{
+using test_function = void (*)();
+
+void add_test(const char *name, test_function function);
+
+void add_failure(const char *file, int line, const std::string &message);
+
+class registrar
+{
+  public:
+    registrar(const char *name, test_function function)
+    {
+        add_test(name, function);
+    }
+};
+
+template <typename Type>
+[[nodiscard]] std::string to_string(const Type &value)
+{
+    std::ostringstream stream;
+    stream << value;
+    return stream.str();
+}
+} // namespace host_test
+
+#define HOST_TEST(name)                                                        \
+    static void name();                                                        \
+    static host_test::registrar name##_registrar(#name, name);                 \
+    static void name()
+
+#define CHECK(condition)                                                       \
+    do                                                                         \
+    {                                                                          \
+        if (!(condition))                                                      \
+        {                                                                      \
+            host_test::add_failure(__FILE__, __LINE__,                         \
+                                   "CHECK(" #condition ")");                   \
+        }                                                                      \
+    } while (false)
+
+#define CHECK_EQUAL(actual, expected)                                          \
+    do                                                                         \
+    {                                                                          \
+        const auto &check_actual = (actual);                                   \
+        const auto &check_expected = (expected);                               \
+                                                                               \
+        if (!(check_actual == check_expected))                                 \
+        {                                                                      \
+            host_test::add_failure(                                            \
+                __FILE__, __LINE__,                                            \
+                "CHECK_EQUAL(" #actual ", " #expected "): " +                  \
+                    host_test::to_string(check_actual) +                       \
+                    " != " + host_test::to_string(check_expected));            \
+        }                                                                      \
+    } while (false)
+
+#endif
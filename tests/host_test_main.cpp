@@ -0,0 +1,59 @@
+/*
+ * Minimal test runner of the host tests, see host_test.h.
+ */
+
+#include <vector>
+
+#include "host_test.h"
+
+namespace host_test
+{
+namespace
+{
+struct test
+{
+    const char *name;
+    test_function function;
+};
+
+std::vector<test> &tests()
+{
+    static std::vector<test> result;
+    return result;
+}
+
+int failures = 0;
+} // namespace
+
+void add_test(const char *name, test_function function)
+{
+    tests().push_back({name, function});
+}
+
+void add_failure(const char *file, int line, const std::string &message)
+{
+    std::fprintf(stderr, "%s:%d: %s\n", file, line, message.c_str());
+    ++failures;
+}
+} // namespace host_test
+
+int main()
+{
+    int failed_tests = 0;
+
+    for (const host_test::test &test : host_test::tests())
+    {
+        int previous_failures = host_test::failures;
+        test.function();
+
+        if (host_test::failures != previous_failures)
+        {
+            std::fprintf(stderr, "FAILED: %s\n", test.name);
+            ++failed_tests;
+        }
+    }
+
+    std::printf("%d tests, %d failed\n", int(host_test::tests().size()),
+                failed_tests);
+    return failed_tests ? 1 : 0;
+}
@@ -0,0 +1,272 @@
+/*
+ * Rasterizer of the emulated sprites hardware of the Butano stub.
+ */
+
+#include "host_video.h"
+
+#include <cmath>
+#include <fstream>
+
+#include "bn_host.h"
+#include "bn_memory.h"
+
+#include "../../../butano/butano/hw/include/bn_hw_sprites.h"
+
+namespace host_video
+{
+namespace
+{
+constexpr int sprite_widths[3][4] = {
+    {8, 16, 32, 64}, {16, 32, 32, 64}, {8, 8, 16, 32}};
+constexpr int sprite_heights[3][4] = {
+    {8, 16, 32, 64}, {8, 8, 16, 32}, {16, 32, 32, 64}};
+
+[[nodiscard]] bn::color faded_color(const bn::host::palette_entry &palette,
+                                    int color_index)
+{
+    bn::color color = palette.colors[color_index];
+    int intensity = palette.fade_intensity.data();
+
+    if (!intensity)
+    {
+        return color;
+    }
+
+    bn::color fade_color = palette.fade_color;
+    auto fade = [intensity](int from, int to) {
+        return from + (((to - from) * intensity) >> 12);
+    };
+
+    return bn::color(fade(color.red(), fade_color.red()),
+                     fade(color.green(), fade_color.green()),
+                     fade(color.blue(), fade_color.blue()));
+}
+
+void draw_sprite_line(const bn::hw::sprites::handle &handle, int y,
+                      bn::color *output_line)
+{
+    int attr0 = handle.attr0;
+    int affine_mode = attr0 & ATTR0_MODE_MASK;
+
+    if (affine_mode == ATTR0_HIDE)
+    {
+        return;
+    }
+
+    int attr1 = handle.attr1;
+    int attr2 = handle.attr2;
+    int shape = attr0 >> 14;
+    int size = attr1 >> 14;
+
+    if (shape > 2)
+    {
+        return;
+    }
+
+    int sprite_width = sprite_widths[shape][size];
+    int sprite_height = sprite_heights[shape][size];
+    int bounds_width = sprite_width;
+    int bounds_height = sprite_height;
+
+    if (affine_mode == ATTR0_AFF_DBL)
+    {
+        bounds_width *= 2;
+        bounds_height *= 2;
+    }
+
+    int sprite_y = (y - (attr0 & ATTR0_Y_MASK)) & 0xFF;
+
+    if (sprite_y >= bounds_height)
+    {
+        return;
+    }
+
+    const bn::host::tiles_entry *tiles =
+        bn::host::tiles(attr2 & ATTR2_ID_MASK);
+    const bn::host::palette_entry *palette =
+        bn::host::palette(attr2 >> ATTR2_PALBANK_SHIFT);
+
+    if (!tiles || !palette)
+    {
+        return;
+    }
+
+    const bn::sprite_tiles_item &tiles_item = *tiles->item;
+
+    if (tiles_item.width() != sprite_width ||
+        tiles_item.height() != sprite_height)
+    {
+        return;
+    }
+
+    int x = attr1 & ATTR1_X_MASK;
+
+    // Affine sprites are sampled from the center of their bounds, like the
+    // GBA does. Matrix is the one of Butano affine mats without shear:
+    double pa = 1;
+    double pb = 0;
+    double pc = 0;
+    double pd = 1;
+
+    if (affine_mode != ATTR0_REG)
+    {
+        const bn::host::affine_mat_entry *affine_mat =
+            bn::host::affine_mat((attr1 >> ATTR1_AFF_ID_SHIFT) & 0x1F);
+
+        if (!affine_mat)
+        {
+            return;
+        }
+
+        double angle =
+            affine_mat->rotation_angle.to_double() * 3.14159265358979 / 180;
+        double scale = affine_mat->scale.to_double();
+        pa = std::cos(angle) / scale;
+        pb = std::sin(angle) / scale;
+        pc = -std::sin(angle) / scale;
+        pd = std::cos(angle) / scale;
+    }
+
+    for (int bounds_x = 0; bounds_x < bounds_width; ++bounds_x)
+    {
+        int screen_x = (x + bounds_x) & ATTR1_X_MASK;
+
+        if (screen_x >= width)
+        {
+            continue;
+        }
+
+        int texture_x;
+        int texture_y;
+
+        if (affine_mode == ATTR0_REG)
+        {
+            texture_x =
+                attr1 & ATTR1_HFLIP ? sprite_width - 1 - bounds_x : bounds_x;
+            texture_y =
+                attr1 & ATTR1_VFLIP ? sprite_height - 1 - sprite_y : sprite_y;
+        }
+        else
+        {
+            double dx = bounds_x - bounds_width / 2;
+            double dy = sprite_y - bounds_height / 2;
+            texture_x = int(std::floor(pa * dx + pb * dy)) + sprite_width / 2;
+            texture_y = int(std::floor(pc * dx + pd * dy)) + sprite_height / 2;
+
+            if (texture_x < 0 || texture_x >= sprite_width || texture_y < 0 ||
+                texture_y >= sprite_height)
+            {
+                continue;
+            }
+        }
+
+        if (int color_index = tiles_item.pixel(tiles->graphics_index,
+                                               texture_x, texture_y))
+        {
+            output_line[screen_x] = faded_color(*palette, color_index);
+        }
+    }
+}
+} // namespace
+
+void draw(frame &output)
+{
+    output.fill(bn::color(0, 0, 0));
+
+    bn::hw::sprites::handle *oam = bn::hw::sprites::vram();
+    const bn::host::hdma_transfer *hdma = bn::host::hdma();
+
+    for (int y = 0; y < height; ++y)
+    {
+        if (hdma)
+        {
+            // Line 0 is drawn with the last block of the transfer, which is
+            // copied when HDMA is started:
+            int transfer_index = y ? y - 1 : height - 1;
+            bn::memory::copy(
+                hdma->source[transfer_index * hdma->elements], hdma->elements,
+                *hdma->destination);
+        }
+
+        bn::color *output_line = output.data() + (y * width);
+
+        // Lower OAM indexes are drawn over higher ones with the same
+        // priority:
+        for (int priority = 3; priority >= 0; --priority)
+        {
+            for (int index = bn::hw::sprites::count() - 1; index >= 0; --index)
+            {
+                const bn::hw::sprites::handle &handle = oam[index];
+
+                if (((handle.attr2 >> ATTR2_PRIO_SHIFT) & 3) == priority)
+                {
+                    draw_sprite_line(handle, y, output_line);
+                }
+            }
+        }
+    }
+
+    // Last transfer is done in the horizontal blank of the last line too, so
+    // it's kept in OAM if HDMA is stopped or changed before the next frame:
+    if (hdma)
+    {
+        bn::memory::copy(hdma->source[(height - 1) * hdma->elements],
+                         hdma->elements, *hdma->destination);
+    }
+}
+
+bool write_ppm(const frame &input, const std::string &path)
+{
+    std::ofstream file(path, std::ios::binary);
+    file << "P6\n" << width << ' ' << height << "\n255\n";
+
+    for (bn::color color : input)
+    {
+        char rgb[3] = {char(color.red() * 255 / 31),
+                       char(color.green() * 255 / 31),
+                       char(color.blue() * 255 / 31)};
+        file.write(rgb, 3);
+    }
+
+    return bool(file);
+}
+
+bool read_ppm(const std::string &path, frame &output)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::string magic;
+    int file_width = 0;
+    int file_height = 0;
+    int max_value = 0;
+    file >> magic >> file_width >> file_height >> max_value;
+    file.get();
+
+    if (!file || magic != "P6" || file_width != width ||
+        file_height != height || max_value != 255)
+    {
+        return false;
+    }
+
+    for (bn::color &color : output)
+    {
+        unsigned char rgb[3];
+        file.read(reinterpret_cast<char *>(rgb), 3);
+        color = bn::color((rgb[0] * 31 + 127) / 255, (rgb[1] * 31 + 127) / 255,
+                          (rgb[2] * 31 + 127) / 255);
+    }
+
+    return bool(file);
+}
+
+int diff(const frame &a, const frame &b)
+{
+    int result = 0;
+
+    for (int index = 0; index < width * height; ++index)
+    {
+        result += a[index] != b[index];
+    }
+
+    return result;
+}
+} // namespace host_video
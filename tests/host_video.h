@@ -0,0 +1,36 @@
+/*
+ * Rasterizer of the emulated sprites hardware of the Butano stub.
+ */
+
+#ifndef HOST_VIDEO_H
+#define HOST_VIDEO_H
+
+#include <string>
+
+#include "bn_array.h"
+#include "bn_color.h"
+#include "bn_display.h"
+
+namespace host_video
+{
+constexpr int width = bn::display::width();
+constexpr int height = bn::display::height();
+
+using frame = bn::array<bn::color, width * height>;
+
+// Draws the sprites of OAM as they would appear on screen, applying the
+// running HDMA transfer line by line. OAM is updated by HDMA like on the GBA,
+// so sprites left by a transfer are kept in the next lines and frames.
+//
+// Backdrop is black.
+void draw(frame &output);
+
+[[nodiscard]] bool write_ppm(const frame &input, const std::string &path);
+
+[[nodiscard]] bool read_ppm(const std::string &path, frame &output);
+
+// Number of pixels which are different between both frames:
+[[nodiscard]] int diff(const frame &a, const frame &b);
+} // namespace host_video
+
+#endif
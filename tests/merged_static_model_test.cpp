@@ -0,0 +1,108 @@
+/*
+ * Tests of the collision data kept by merged_static_model_3d_item.
+ */
+
+#include "merged_static_model_3d_item.h"
+#include "static_model_3d_item.h"
+
+#include "models/bush.h"
+
+#include "host_test.h"
+
+namespace
+{
+// Two quads sharing their first edge, so the second one's vertex indexes
+// change when merged:
+constexpr fr::vertex_3d first_vertices[] = {
+    fr::vertex_3d(0, 0, 0), fr::vertex_3d(0, 0, 8), fr::vertex_3d(8, 0, 8),
+    fr::vertex_3d(8, 0, 0)};
+
+constexpr fr::face_3d first_faces[] = {
+    fr::face_3d(first_vertices, fr::vertex_3d(0, -1, 0), 0, 1, 2, 3, 0, 0)};
+
+constexpr fr::vertex_3d second_vertices[] = {
+    fr::vertex_3d(-8, 0, 8), fr::vertex_3d(-8, 0, 0), fr::vertex_3d(0, 0, 0),
+    fr::vertex_3d(0, 0, 8)};
+
+constexpr fr::face_3d second_faces[] = {
+    fr::face_3d(second_vertices, fr::vertex_3d(0, -1, 0), 0, 1, 2, 3, 0, 0)};
+
+constexpr fr::model_3d_vertical_cylinder second_cylinder(-4, 4, 6);
+
+constexpr fr::model_3d_item quad_items[] = {
+    fr::model_3d_item(first_vertices, first_faces, nullptr, nullptr,
+                      fr::model_3d_items::bush_colors),
+    fr::model_3d_item(second_vertices, second_faces, &second_faces[0],
+                      &second_cylinder, fr::model_3d_items::bush_colors)};
+
+constexpr merged_static_model_3d_item<quad_items> merged_quads;
+
+constexpr auto first_bush = static_model_3d_item<fr::model_3d_items::bush_full>(
+    fr::point_3d(10, 20, 0), 0);
+constexpr auto second_bush =
+    static_model_3d_item<fr::model_3d_items::bush_full>(
+        fr::point_3d(-30, 60, 0), 8192);
+
+constexpr fr::model_3d_item bush_items[] = {first_bush.item(),
+                                            second_bush.item()};
+
+constexpr merged_static_model_3d_item<bush_items> merged_bushes;
+} // namespace
+
+HOST_TEST(merged_sub_ranges_keep_vertical_cylinders)
+{
+    fr::model_3d_item item = merged_bushes.item();
+    CHECK_EQUAL(item.sub_ranges().size(), 2);
+
+    for (int index = 0; index < 2; ++index)
+    {
+        const fr::model_3d_vertical_cylinder *expected =
+            bush_items[index].vertical_cylinder();
+        const fr::model_3d_vertical_cylinder *actual =
+            item.sub_ranges()[index].vertical_cylinder();
+        CHECK(actual != nullptr);
+
+        if (actual)
+        {
+            CHECK_EQUAL(actual->centroid_x(), expected->centroid_x());
+            CHECK_EQUAL(actual->centroid_z(), expected->centroid_z());
+            CHECK_EQUAL(actual->integer_radius(), expected->integer_radius());
+        }
+    }
+}
+
+HOST_TEST(merged_collision_faces_reference_merged_vertices)
+{
+    fr::model_3d_item item = merged_quads.item();
+    CHECK_EQUAL(item.vertices().size(), 6);
+    CHECK_EQUAL(item.sub_ranges().size(), 2);
+    CHECK(item.sub_ranges()[0].collision_face() == nullptr);
+    CHECK(item.sub_ranges()[0].vertical_cylinder() == nullptr);
+
+    const fr::face_3d *collision_face = item.sub_ranges()[1].collision_face();
+    CHECK(collision_face != nullptr);
+
+    if (collision_face)
+    {
+        const fr::face_3d &expected = second_faces[0];
+        CHECK(!collision_face->triangle());
+        CHECK(item.vertices()[collision_face->first_vertex_index()].point() ==
+              second_vertices[expected.first_vertex_index()].point());
+        CHECK(item.vertices()[collision_face->second_vertex_index()].point() ==
+              second_vertices[expected.second_vertex_index()].point());
+        CHECK(item.vertices()[collision_face->third_vertex_index()].point() ==
+              second_vertices[expected.third_vertex_index()].point());
+        CHECK(item.vertices()[collision_face->fourth_vertex_index()].point() ==
+              second_vertices[expected.fourth_vertex_index()].point());
+    }
+
+    const fr::model_3d_vertical_cylinder *vertical_cylinder =
+        item.sub_ranges()[1].vertical_cylinder();
+    CHECK(vertical_cylinder != nullptr);
+
+    if (vertical_cylinder)
+    {
+        CHECK_EQUAL(vertical_cylinder->centroid_x(), bn::fixed(-4));
+        CHECK_EQUAL(vertical_cylinder->integer_radius(), 6);
+    }
+}
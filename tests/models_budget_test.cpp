@@ -0,0 +1,147 @@
+/*
+ * Tests of the models_3d detail levels and faces budget, built with
+ * FR_MAX_FACES=32.
+ */
+
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include "fr_camera_3d.h"
+#include "fr_models_3d.h"
+
+#include "models/scorpion.h"
+
+#include "host_test.h"
+#include "host_video.h"
+
+namespace
+{
+struct placed_model
+{
+    const fr::model_3d_item *item;
+    fr::point_3d position;
+};
+
+struct render_result
+{
+    host_video::frame frame;
+    int valid_faces_count;
+    int dropped_faces_count;
+};
+
+// Renders the given dynamic models with the default camera orientation,
+// which looks towards -Y from the origin:
+[[nodiscard]] std::unique_ptr<render_result> render(
+    std::initializer_list<placed_model> placed_models)
+{
+    auto models = std::make_unique<fr::models_3d>();
+    models->load_colors(fr::model_3d_items::scorpion_colors);
+
+    fr::camera_3d camera;
+    camera.set_position(fr::point_3d(0, 0, 0));
+
+    std::vector<fr::model_3d *> created_models;
+
+    for (const placed_model &placed_model : placed_models)
+    {
+        fr::model_3d &model = models->create_dynamic_model(*placed_model.item);
+        model.set_position(placed_model.position);
+        created_models.push_back(&model);
+    }
+
+    models->update(camera);
+
+    auto result = std::make_unique<render_result>();
+    host_video::draw(result->frame);
+    result->valid_faces_count = models->valid_faces_count();
+    result->dropped_faces_count = models->dropped_faces_count();
+
+    for (fr::model_3d *model : created_models)
+    {
+        models->destroy_dynamic_model(*model);
+    }
+
+    return result;
+}
+
+[[nodiscard]] int diff_columns(const host_video::frame &a,
+                               const host_video::frame &b, int first_column,
+                               int last_column)
+{
+    int result = 0;
+
+    for (int y = 0; y < host_video::height; ++y)
+    {
+        for (int x = first_column; x < last_column; ++x)
+        {
+            int index = (y * host_video::width) + x;
+            result += a[index] != b[index];
+        }
+    }
+
+    return result;
+}
+
+[[nodiscard]] bool empty_columns(const host_video::frame &frame,
+                                 int first_column, int last_column)
+{
+    host_video::frame empty_frame;
+    empty_frame.fill(bn::color(0, 0, 0));
+    return !diff_columns(frame, empty_frame, first_column, last_column);
+}
+} // namespace
+
+HOST_TEST(lower_detail_is_selected_by_depth)
+{
+    using namespace fr::model_3d_items;
+
+    // scorpion_full switches to scorpion_lod_1 at 320 and to scorpion_lod_2
+    // at 640:
+    for (int depth : {400, 800})
+    {
+        const fr::model_3d_item &expected_item =
+            depth < 640 ? scorpion_lod_1 : scorpion_lod_2;
+        fr::point_3d position(0, -depth, 0);
+        auto full = render({{&scorpion_full, position}});
+        auto expected = render({{&expected_item, position}});
+
+        CHECK(full->valid_faces_count > 0);
+        CHECK_EQUAL(full->valid_faces_count, expected->valid_faces_count);
+        CHECK_EQUAL(host_video::diff(full->frame, expected->frame), 0);
+    }
+
+    fr::point_3d near_position(0, -200, 0);
+    auto full = render({{&scorpion_full, near_position}});
+    auto lod_1 = render({{&scorpion_lod_1, near_position}});
+    CHECK(host_video::diff(full->frame, lod_1->frame) > 0);
+}
+
+HOST_TEST(farthest_faces_are_dropped_when_budget_is_full)
+{
+    using namespace fr::model_3d_items;
+
+    // Near model is drawn in the left half of the screen, and far ones in
+    // the right half:
+    placed_model near_model = {&scorpion_lod_2, fr::point_3d(-40, -200, 0)};
+    auto near_only = render({near_model});
+
+    CHECK(near_only->valid_faces_count < FR_MAX_FACES);
+    CHECK_EQUAL(near_only->dropped_faces_count, 0);
+    CHECK(!empty_columns(near_only->frame, 0, 120));
+    CHECK(empty_columns(near_only->frame, 120, 240));
+
+    // Far models fill the budget before the near one is processed:
+    auto crowded = render({
+        {&scorpion_lod_2, fr::point_3d(80, -500, 0)},
+        {&scorpion_lod_2, fr::point_3d(80, -560, 0)},
+        {&scorpion_lod_2, fr::point_3d(80, -620, 0)},
+        {&scorpion_lod_2, fr::point_3d(80, -680, 0)},
+        near_model,
+    });
+
+    CHECK_EQUAL(crowded->valid_faces_count, FR_MAX_FACES);
+    CHECK(crowded->dropped_faces_count > 0);
+    CHECK_EQUAL(diff_columns(crowded->frame, near_only->frame, 0, 120), 0);
+    CHECK(!empty_columns(crowded->frame, 120, 240));
+}
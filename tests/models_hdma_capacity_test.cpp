@@ -0,0 +1,88 @@
+/*
+ * Tests of the HDMA line capacity chosen for each models_3d.
+ */
+
+#include <memory>
+
+#include "bn_hdma.h"
+
+#include "fr_camera_3d.h"
+#include "fr_models_3d.h"
+
+#include "models/player_ship_02.h"
+
+#include "host_test.h"
+#include "host_video.h"
+
+namespace
+{
+struct render_result
+{
+    host_video::frame frame;
+    int hlines_count;
+    bool hdma_running;
+};
+
+// Renders the player ship of the title scene with the given capacity:
+[[nodiscard]] std::unique_ptr<render_result> render_title_ship(
+    int max_hdma_sprites)
+{
+    auto models = std::make_unique<fr::models_3d>(max_hdma_sprites);
+    models->load_colors(fr::model_3d_items::player_ship_02_colors);
+
+    fr::camera_3d camera;
+    camera.set_position(fr::point_3d(0, 0, 0));
+    camera.set_phi(6000);
+
+    fr::model_3d &model = models->create_dynamic_model(
+        fr::model_3d_items::player_ship_02_full);
+    model.set_position(fr::point_3d(15, -110, 10));
+    model.set_phi(16000);
+    models->update(camera);
+
+    auto result = std::make_unique<render_result>();
+    host_video::draw(result->frame);
+    result->hlines_count = models->hlines_count();
+    result->hdma_running = bn::hdma::running();
+    models->destroy_dynamic_model(model);
+    return result;
+}
+
+[[nodiscard]] int drawn_pixels(const host_video::frame &frame)
+{
+    host_video::frame empty_frame;
+    empty_frame.fill(bn::color(0, 0, 0));
+    return host_video::diff(frame, empty_frame);
+}
+} // namespace
+
+HOST_TEST(title_ship_fits_in_the_title_capacity)
+{
+    auto full = render_title_ship(fr::constants_3d::max_hdma_sprites);
+    auto title = render_title_ship(24);
+
+    CHECK(full->hlines_count > 0);
+    CHECK_EQUAL(title->hlines_count, full->hlines_count);
+    CHECK_EQUAL(host_video::diff(title->frame, full->frame), 0);
+}
+
+HOST_TEST(hlines_over_capacity_are_dropped)
+{
+    auto full = render_title_ship(fr::constants_3d::max_hdma_sprites);
+    auto small = render_title_ship(1);
+
+    CHECK(small->hdma_running);
+    CHECK(small->hlines_count > 0);
+    CHECK(small->hlines_count < full->hlines_count);
+    CHECK(drawn_pixels(small->frame) > 0);
+    CHECK(drawn_pixels(small->frame) < drawn_pixels(full->frame));
+}
+
+HOST_TEST(zero_capacity_draws_nothing)
+{
+    auto empty = render_title_ship(0);
+
+    CHECK(!empty->hdma_running);
+    CHECK_EQUAL(empty->hlines_count, 0);
+    CHECK_EQUAL(drawn_pixels(empty->frame), 0);
+}
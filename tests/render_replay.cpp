@@ -0,0 +1,570 @@
+/*
+ * Replays camera and model paths through fr::models_3d in the host.
+ *
+ *   render_replay [--golden-dir DIR] [--output-dir DIR] [--update-golden]
+ *                 [--repeat N] REPLAY...
+ *
+ * Each replay is a list of frames. A frame starts with a "frame" line and is
+ * followed by its camera, the dynamic models alive in it and optionally the
+ * name of the golden image it's compared with:
+ *
+ *   frame
+ *   camera x y z phi theta psi
+ *   model name x y z phi theta psi scale
+ *   golden name
+ *
+ * Lines starting with # are ignored. Static models are the ones of
+ * static_scene below.
+ *
+ * Reports ns/frame of models_3d::update (and of each profiler section) and
+ * the render stats of each replay. Exits with an error if a frame doesn't
+ * match its golden image.
+ *
+ * Golden images are the frames of the baseline renderer. Known differences
+ * of the current one are read from known_diffs.txt in the golden directory,
+ * with lines like "name different_pixels", and a frame only matches its golden
+ * image if it has exactly that many different pixels. --update-golden doesn't
+ * change known_diffs.txt.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bn_host.h"
+#include "bn_profiler.h"
+
+#include "fr_camera_3d.h"
+#include "fr_models_3d.h"
+
+#include "models/asteroid1.h"
+#include "models/big_asteroid_1.h"
+#include "models/bush.h"
+#include "models/moon_oyster.h"
+#include "models/player_ship_02.h"
+
+#include "static_model_3d_item.h"
+
+#include "host_video.h"
+
+namespace
+{
+using namespace scene_colors_generator;
+
+// --- Scene
+
+constexpr auto _asteroid_1 =
+    static_model_3d_item<fr::model_3d_items::big_asteroid_1_full>(
+        fr::point_3d(-60, -300, -30), 16000);
+constexpr auto _asteroid_2 =
+    static_model_3d_item<fr::model_3d_items::big_asteroid_1_full>(
+        fr::point_3d(50, -520, 40), -8000);
+constexpr auto _asteroid_3 =
+    static_model_3d_item<fr::model_3d_items::big_asteroid_1_full>(
+        fr::point_3d(-20, -760, 60), 4000);
+constexpr auto _bush_1 = static_model_3d_item<fr::model_3d_items::bush_full>(
+    fr::point_3d(30, -400, -50), 0);
+constexpr auto _bush_2 = static_model_3d_item<fr::model_3d_items::bush_full>(
+    fr::point_3d(-40, -640, -50), 12000);
+
+constexpr fr::model_3d_item static_scene[] = {
+    _asteroid_1.item(), _asteroid_2.item(), _asteroid_3.item(),
+    _bush_1.item(),     _bush_2.item(),
+};
+
+struct dynamic_model_item
+{
+    const char *name;
+    const fr::model_3d_item *item;
+};
+
+constexpr dynamic_model_item dynamic_model_items[] = {
+    {"player_ship_02", &fr::model_3d_items::player_ship_02_full},
+    {"asteroid1", &fr::model_3d_items::asteroid1_full},
+    {"moon_oyster", &fr::model_3d_items::moon_oyster_full},
+    {"bush", &fr::model_3d_items::bush_full},
+};
+
+constexpr const auto raw_scene_colors = {
+    bn::span<const bn::color>(fr::model_3d_items::player_ship_02_colors),
+    bn::span<const bn::color>(fr::model_3d_items::big_asteroid_1_colors),
+    bn::span<const bn::color>(fr::model_3d_items::asteroid1_colors),
+    bn::span<const bn::color>(fr::model_3d_items::moon_oyster_colors),
+    bn::span<const bn::color>(fr::model_3d_items::bush_colors),
+};
+
+constexpr size_t model_palette_count = raw_scene_colors.size();
+constexpr size_t scene_palette_size = calculate_total_size(raw_scene_colors);
+
+constexpr bn::array<bn::color, scene_palette_size> scene_colors =
+    generate_scene_colors<scene_palette_size>(raw_scene_colors);
+
+// --- Replays
+
+struct model_state
+{
+    const fr::model_3d_item *item;
+    fr::point_3d position;
+    bn::fixed phi;
+    bn::fixed theta;
+    bn::fixed psi;
+    bn::fixed scale;
+};
+
+struct frame_state
+{
+    fr::point_3d camera_position;
+    bn::fixed camera_phi;
+    bn::fixed camera_theta;
+    bn::fixed camera_psi;
+    std::vector<model_state> models;
+    std::string golden;
+};
+
+struct options
+{
+    std::string golden_dir = "golden";
+    std::string output_dir;
+    bool update_golden = false;
+    int repeat = 1;
+    std::vector<std::string> replays;
+};
+
+[[nodiscard]] const fr::model_3d_item *find_dynamic_model_item(
+    const std::string &name)
+{
+    for (const dynamic_model_item &item : dynamic_model_items)
+    {
+        if (name == item.name)
+        {
+            return item.item;
+        }
+    }
+
+    return nullptr;
+}
+
+// Known different pixels of each golden image (empty if there's no file):
+[[nodiscard]] std::map<std::string, int> read_known_diffs(
+    const std::string &golden_dir)
+{
+    std::map<std::string, int> result;
+    std::ifstream file(golden_dir + "/known_diffs.txt");
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        std::istringstream stream(line);
+        std::string name;
+        int different_pixels = 0;
+
+        if (stream >> name && name[0] != '#' && stream >> different_pixels)
+        {
+            result[name] = different_pixels;
+        }
+    }
+
+    return result;
+}
+
+[[nodiscard]] bool read_replay(const std::string &path,
+                               std::vector<frame_state> &frames)
+{
+    std::ifstream file(path);
+
+    if (!file)
+    {
+        std::fprintf(stderr, "%s: can't open file\n", path.c_str());
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+
+    while (std::getline(file, line))
+    {
+        ++line_number;
+
+        std::istringstream stream(line);
+        std::string command;
+
+        if (!(stream >> command) || command[0] == '#')
+        {
+            continue;
+        }
+
+        double x = 0, y = 0, z = 0, phi = 0, theta = 0, psi = 0, scale = 1;
+        bool valid = true;
+
+        if (command == "frame")
+        {
+            frames.emplace_back();
+        }
+        else if (frames.empty())
+        {
+            valid = false;
+        }
+        else if (command == "camera")
+        {
+            valid = bool(stream >> x >> y >> z >> phi >> theta >> psi);
+
+            frame_state &frame = frames.back();
+            frame.camera_position = fr::point_3d(x, y, z);
+            frame.camera_phi = phi;
+            frame.camera_theta = theta;
+            frame.camera_psi = psi;
+        }
+        else if (command == "model")
+        {
+            std::string name;
+            valid = bool(stream >> name >> x >> y >> z >> phi >> theta >>
+                         psi >> scale);
+
+            const fr::model_3d_item *item = find_dynamic_model_item(name);
+            valid = valid && item;
+
+            if (valid)
+            {
+                frames.back().models.push_back(
+                    {item, fr::point_3d(x, y, z), phi, theta, psi, scale});
+            }
+        }
+        else if (command == "golden")
+        {
+            valid = bool(stream >> frames.back().golden);
+        }
+        else
+        {
+            valid = false;
+        }
+
+        if (!valid)
+        {
+            std::fprintf(stderr, "%s:%d: invalid line: %s\n", path.c_str(),
+                         line_number, line.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+struct replay_stats
+{
+    int frames = 0;
+    long long total_nanoseconds = 0;
+    long long max_nanoseconds = 0;
+    long long valid_faces = 0;
+    int max_valid_faces = 0;
+    long long visible_faces = 0;
+    int max_visible_faces = 0;
+    long long hlines = 0;
+    int max_hlines = 0;
+    int render_arena_bytes = 0;
+    int golden_frames = 0;
+    int golden_failures = 0;
+};
+
+class replayer
+{
+  public:
+    explicit replayer(const options &options)
+        : _options(options), _known_diffs(read_known_diffs(options.golden_dir))
+    {
+        _models.load_colors(scene_colors, &_color_mapping);
+
+        for (int index = 0; index < int(std::size(static_scene)); ++index)
+        {
+            _static_model_items[index] = &static_scene[index];
+        }
+
+        _models.set_retained_static_model_items(_static_model_items,
+                                                int(std::size(static_scene)));
+    }
+
+    ~replayer()
+    {
+        for (fr::model_3d *model : _dynamic_models)
+        {
+            _models.destroy_dynamic_model(*model);
+        }
+    }
+
+    void play(const std::vector<frame_state> &frames, bool check_golden,
+              replay_stats &stats)
+    {
+        for (const frame_state &frame : frames)
+        {
+            _setup(frame);
+
+            auto start = std::chrono::steady_clock::now();
+            _models.update(_camera);
+
+            long long nanoseconds =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+
+            ++stats.frames;
+            stats.total_nanoseconds += nanoseconds;
+            stats.max_nanoseconds = std::max(stats.max_nanoseconds, nanoseconds);
+            stats.valid_faces += _models.valid_faces_count();
+            stats.max_valid_faces =
+                std::max(stats.max_valid_faces, _models.valid_faces_count());
+            stats.visible_faces += _models.visible_faces_count();
+            stats.max_visible_faces = std::max(stats.max_visible_faces,
+                                               _models.visible_faces_count());
+            stats.hlines += _models.hlines_count();
+            stats.max_hlines =
+                std::max(stats.max_hlines, _models.hlines_count());
+
+            if (check_golden && !frame.golden.empty())
+            {
+                ++stats.golden_frames;
+
+                if (!_check_golden(frame.golden))
+                {
+                    ++stats.golden_failures;
+                }
+            }
+        }
+
+        stats.render_arena_bytes = std::max(
+            stats.render_arena_bytes, _models.render_arena_high_water_mark());
+    }
+
+  private:
+    const options &_options;
+    std::map<std::string, int> _known_diffs;
+    scene_colors_generator::color_mapping_handler _color_mapping{
+        model_palette_count, scene_palette_size, raw_scene_colors.begin(),
+        scene_colors.data()};
+    fr::models_3d _models;
+    fr::camera_3d _camera;
+    const fr::model_3d_item *_static_model_items[std::size(static_scene)];
+    std::vector<fr::model_3d *> _dynamic_models;
+    host_video::frame _frame;
+    host_video::frame _golden_frame;
+
+    void _setup(const frame_state &frame)
+    {
+        _camera.set_position(frame.camera_position);
+        _camera.set_phi(frame.camera_phi);
+        _camera.set_theta(frame.camera_theta);
+        _camera.set_psi(frame.camera_psi);
+
+        // Models are kept alive between frames while their item doesn't
+        // change, like in the game:
+        int models_count = int(frame.models.size());
+
+        while (int(_dynamic_models.size()) > models_count)
+        {
+            _models.destroy_dynamic_model(*_dynamic_models.back());
+            _dynamic_models.pop_back();
+        }
+
+        for (int index = 0; index < models_count; ++index)
+        {
+            const model_state &state = frame.models[index];
+
+            if (index < int(_dynamic_models.size()) &&
+                &_dynamic_models[index]->item() != state.item)
+            {
+                _models.destroy_dynamic_model(*_dynamic_models[index]);
+                _dynamic_models[index] = &_models.create_dynamic_model(
+                    *state.item);
+            }
+            else if (index == int(_dynamic_models.size()))
+            {
+                _dynamic_models.push_back(
+                    &_models.create_dynamic_model(*state.item));
+            }
+
+            fr::model_3d &model = *_dynamic_models[index];
+            model.set_position(state.position);
+            model.set_phi(state.phi);
+            model.set_theta(state.theta);
+            model.set_psi(state.psi);
+            model.set_scale(state.scale);
+        }
+    }
+
+    [[nodiscard]] bool _check_golden(const std::string &name)
+    {
+        host_video::draw(_frame);
+
+        std::string file_name = name + ".ppm";
+        std::string golden_path = _options.golden_dir + '/' + file_name;
+
+        if (_options.update_golden)
+        {
+            if (!host_video::write_ppm(_frame, golden_path))
+            {
+                std::fprintf(stderr, "%s: can't write file\n",
+                             golden_path.c_str());
+                return false;
+            }
+
+            return true;
+        }
+
+        if (!_options.output_dir.empty())
+        {
+            std::string output_path = _options.output_dir + '/' + file_name;
+
+            if (!host_video::write_ppm(_frame, output_path))
+            {
+                std::fprintf(stderr, "%s: can't write file\n",
+                             output_path.c_str());
+            }
+        }
+
+        if (!host_video::read_ppm(golden_path, _golden_frame))
+        {
+            std::fprintf(stderr, "%s: can't read golden image\n",
+                         golden_path.c_str());
+            return false;
+        }
+
+        int different_pixels = host_video::diff(_frame, _golden_frame);
+        auto known_diff = _known_diffs.find(name);
+        int known_different_pixels =
+            known_diff != _known_diffs.end() ? known_diff->second : 0;
+
+        if (different_pixels != known_different_pixels)
+        {
+            std::fprintf(stderr,
+                         "%s: %d pixels are different (%d expected, see "
+                         "known_diffs.txt)\n",
+                         golden_path.c_str(), different_pixels,
+                         known_different_pixels);
+            return false;
+        }
+
+        return true;
+    }
+};
+
+[[nodiscard]] bool parse_options(int argc, char **argv, options &result)
+{
+    for (int index = 1; index < argc; ++index)
+    {
+        const char *argument = argv[index];
+        bool has_value = index + 1 < argc;
+
+        if (!std::strcmp(argument, "--golden-dir") && has_value)
+        {
+            result.golden_dir = argv[++index];
+        }
+        else if (!std::strcmp(argument, "--output-dir") && has_value)
+        {
+            result.output_dir = argv[++index];
+        }
+        else if (!std::strcmp(argument, "--update-golden"))
+        {
+            result.update_golden = true;
+        }
+        else if (!std::strcmp(argument, "--repeat") && has_value)
+        {
+            result.repeat = std::max(std::atoi(argv[++index]), 1);
+        }
+        else if (argument[0] == '-')
+        {
+            return false;
+        }
+        else
+        {
+            result.replays.push_back(argument);
+        }
+    }
+
+    return !result.replays.empty();
+}
+
+void print_stats(const std::string &replay, const replay_stats &stats)
+{
+    double frames = std::max(stats.frames, 1);
+
+    std::printf("%s: %d frames\n", replay.c_str(), stats.frames);
+    std::printf("  update: %.0f ns/frame (max %lld ns)\n",
+                double(stats.total_nanoseconds) / frames,
+                stats.max_nanoseconds);
+    std::printf("  valid faces: %.1f avg, %d max\n",
+                double(stats.valid_faces) / frames, stats.max_valid_faces);
+    std::printf("  visible faces: %.1f avg, %d max\n",
+                double(stats.visible_faces) / frames, stats.max_visible_faces);
+    std::printf("  hlines: %.1f avg, %d max\n", double(stats.hlines) / frames,
+                stats.max_hlines);
+    std::printf("  render arena: %d of %d bytes, render cache: %d bytes\n",
+                stats.render_arena_bytes, fr::models_3d::render_arena_size(),
+                fr::models_3d::render_cache_size());
+
+    for (const bn::host::profiler_entry &entry : bn::host::profiler_entries())
+    {
+        std::printf("  %s: %.0f ns/frame\n", entry.id.c_str(),
+                    double(entry.total_nanoseconds) / frames);
+    }
+
+    if (stats.golden_frames)
+    {
+        std::printf("  golden frames: %d, failed: %d\n", stats.golden_frames,
+                    stats.golden_failures);
+    }
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    options options;
+
+    if (!parse_options(argc, argv, options))
+    {
+        std::fprintf(stderr,
+                     "Usage: %s [--golden-dir DIR] [--output-dir DIR] "
+                     "[--update-golden] [--repeat N] REPLAY...\n",
+                     argv[0]);
+        return 2;
+    }
+
+    if (!options.output_dir.empty())
+    {
+        std::error_code error;
+        std::filesystem::create_directories(options.output_dir, error);
+    }
+
+    int golden_failures = 0;
+
+    for (const std::string &replay : options.replays)
+    {
+        std::vector<frame_state> frames;
+
+        if (!read_replay(replay, frames))
+        {
+            return 1;
+        }
+
+        replay_stats stats;
+        bn::profiler::reset();
+
+        {
+            replayer replayer(options);
+
+            for (int iteration = 0; iteration < options.repeat; ++iteration)
+            {
+                replayer.play(frames, !iteration, stats);
+            }
+        }
+
+        print_stats(replay, stats);
+        golden_failures += stats.golden_failures;
+    }
+
+    return golden_failures ? 1 : 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * Tests of the hlines added to shape_groups and the sprites HDMA writes for
+ * them. Built with and without FR_COVERAGE_BUFFER.
+ */
+
+#include <memory>
+
+#include "fr_shape_groups.h"
+
+#include "host_test.h"
+#include "host_video.h"
+
+namespace
+{
+constexpr bn::color colors[] = {bn::color(31, 0, 0), bn::color(0, 31, 0)};
+
+class hlines_frame
+{
+  public:
+    fr::shape_groups::hline hlines[bn::display::height()] = {};
+
+    // Adds an hline for each screen line in [minimum_y, maximum_y]:
+    void add(fr::shape_groups &groups, int minimum_y, int maximum_y, int xl,
+             int xr, int color_index)
+    {
+        for (int y = minimum_y; y <= maximum_y; ++y)
+        {
+            hlines[y] = {xl, xr};
+        }
+
+        groups.add_hlines(unsigned(minimum_y), unsigned(maximum_y), xr - xl,
+                          false, color_index, 0, hlines);
+    }
+};
+
+[[nodiscard]] std::unique_ptr<fr::shape_groups> create_groups(
+    int max_hdma_sprites)
+{
+    auto result = std::make_unique<fr::shape_groups>(max_hdma_sprites);
+    result->load_colors(colors);
+    return result;
+}
+
+[[nodiscard]] std::unique_ptr<host_video::frame> draw()
+{
+    auto result = std::make_unique<host_video::frame>();
+    host_video::draw(*result);
+    return result;
+}
+
+[[nodiscard]] bool drawn(const host_video::frame &frame, int x, int y)
+{
+    return frame[(y * host_video::width) + x] != bn::color(0, 0, 0);
+}
+
+[[nodiscard]] int drawn_pixels(const host_video::frame &frame)
+{
+    host_video::frame empty_frame;
+    empty_frame.fill(bn::color(0, 0, 0));
+    return host_video::diff(frame, empty_frame);
+}
+} // namespace
+
+HOST_TEST(touching_hlines_of_the_same_color_are_merged)
+{
+    auto groups = create_groups(4);
+    hlines_frame frame;
+    groups->enable_drawing();
+    frame.add(*groups, 10, 10, 20, 29, 0);
+    frame.add(*groups, 10, 10, 30, 39, 0);
+    frame.add(*groups, 11, 11, 20, 29, 0);
+    frame.add(*groups, 11, 11, 31, 39, 0);
+    groups->update();
+
+    CHECK_EQUAL(groups->hlines_count(), 3);
+
+    auto output = draw();
+    CHECK(drawn(*output, 20, 10));
+    CHECK(drawn(*output, 39, 10));
+    CHECK(!drawn(*output, 40, 10));
+    CHECK(!drawn(*output, 30, 11));
+    CHECK_EQUAL(drawn_pixels(*output), 20 + 19);
+}
+
+HOST_TEST(hlines_of_different_colors_are_not_merged)
+{
+    auto groups = create_groups(4);
+    hlines_frame frame;
+    groups->enable_drawing();
+    frame.add(*groups, 10, 10, 20, 29, 0);
+    frame.add(*groups, 10, 10, 30, 39, 1);
+    groups->update();
+
+    CHECK_EQUAL(groups->hlines_count(), 2);
+
+    auto output = draw();
+    int line_index = 10 * host_video::width;
+    CHECK((*output)[line_index + 29] != (*output)[line_index + 30]);
+    CHECK_EQUAL(drawn_pixels(*output), 20);
+}
+
+HOST_TEST(hlines_beyond_the_line_capacity_are_not_drawn)
+{
+    auto groups = create_groups(2);
+    hlines_frame frame;
+    groups->enable_drawing();
+    frame.add(*groups, 10, 10, 20, 29, 0);
+    frame.add(*groups, 10, 10, 40, 49, 1);
+    frame.add(*groups, 10, 10, 60, 69, 0);
+    groups->update();
+
+    CHECK_EQUAL(groups->hlines_count(), 2);
+    CHECK_EQUAL(groups->hdma_sprites_count(), 2);
+
+    auto output = draw();
+    CHECK(drawn(*output, 40, 10));
+    CHECK(!drawn(*output, 60, 10));
+}
+
+HOST_TEST(shrunk_hdma_window_leaves_no_stale_sprites)
+{
+    auto groups = create_groups(8);
+
+    // Busy frame:
+    hlines_frame busy_frame;
+    groups->enable_drawing();
+
+    for (int index = 0; index < 6; ++index)
+    {
+        busy_frame.add(*groups, 0, 40, index * 20, (index * 20) + 9,
+                       index % 2);
+    }
+
+    groups->update();
+    CHECK_EQUAL(groups->hdma_sprites_count(), 8);
+    (void)draw();
+
+    // Light frame which touches screen line 0. HDMA still writes the sprites
+    // of the busy frame to hide them:
+    hlines_frame light_frame;
+    groups->enable_drawing();
+    light_frame.add(*groups, 0, 0, 100, 109, 1);
+    light_frame.add(*groups, 1, 20, 10, 19, 0);
+    groups->update();
+    CHECK_EQUAL(groups->hdma_sprites_count(), 6);
+
+    auto light_output = draw();
+    CHECK_EQUAL(drawn_pixels(*light_output), 10 + (20 * 10));
+
+    // Same light frame again, written with a smaller HDMA window:
+    groups->enable_drawing();
+    light_frame.add(*groups, 0, 0, 100, 109, 1);
+    light_frame.add(*groups, 1, 20, 10, 19, 0);
+    groups->update();
+    CHECK_EQUAL(groups->hdma_sprites_count(), 1);
+
+    auto shrunk_output = draw();
+    CHECK_EQUAL(host_video::diff(*shrunk_output, *light_output), 0);
+
+    // Empty frame:
+    groups->enable_drawing();
+    groups->update();
+    (void)draw();
+
+    groups->enable_drawing();
+    groups->update();
+    CHECK_EQUAL(drawn_pixels(*draw()), 0);
+}
+
+#if FR_COVERAGE_BUFFER
+HOST_TEST(covered_hlines_are_dropped)
+{
+    auto groups = create_groups(4);
+    hlines_frame frame;
+    groups->enable_drawing();
+    frame.add(*groups, 10, 10, 10, 30, 0);
+    frame.add(*groups, 10, 10, 31, 50, 1);
+    frame.add(*groups, 10, 10, 20, 25, 1);
+    frame.add(*groups, 10, 10, 15, 45, 0);
+    groups->update();
+
+    CHECK_EQUAL(groups->hlines_count(), 2);
+
+    auto output = draw();
+    int line_index = 10 * host_video::width;
+    CHECK((*output)[line_index + 20] == (*output)[line_index + 30]);
+    CHECK((*output)[line_index + 30] != (*output)[line_index + 31]);
+    CHECK_EQUAL(drawn_pixels(*output), 41);
+}
+
+HOST_TEST(partially_covered_hlines_are_kept)
+{
+    auto groups = create_groups(4);
+    hlines_frame frame;
+    groups->enable_drawing();
+    frame.add(*groups, 10, 10, 10, 50, 0);
+    frame.add(*groups, 10, 10, 40, 60, 1);
+    frame.add(*groups, 10, 10, 60, 70, 0);
+    groups->update();
+
+    CHECK_EQUAL(groups->hlines_count(), 3);
+
+    auto output = draw();
+    CHECK(drawn(*output, 70, 10));
+    CHECK_EQUAL(drawn_pixels(*output), 61);
+}
+#endif
@@ -0,0 +1,188 @@
+/*
+ * Tests of the stage events consumed by stage_event_cursor.
+ */
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "stage_event_cursor.h"
+
+#include "host_test.h"
+
+namespace
+{
+struct stage
+{
+    std::vector<stage_section> sections;
+    std::vector<const stage_section *> pointers;
+    std::vector<stage_event> events;
+};
+
+// Random overlapping sections along -Y, some of them empty:
+[[nodiscard]] stage random_stage(std::mt19937 &random)
+{
+    std::uniform_int_distribution<int> gap(0, 60);
+    std::uniform_int_distribution<int> length(0, 300);
+    stage result;
+    int starting_pos = 0;
+
+    for (int index = 0; index < 32; ++index)
+    {
+        result.sections.emplace_back(
+            starting_pos, starting_pos - length(random),
+            std::initializer_list<fr::model_3d_item>{},
+            std::initializer_list<enemy_def>{});
+        starting_pos -= gap(random);
+    }
+
+    for (const stage_section &section : result.sections)
+    {
+        result.pointers.push_back(&section);
+    }
+
+    std::shuffle(result.pointers.begin(), result.pointers.end(), random);
+
+    // Sorted like generate_scene_header.py does, despawns first on ties:
+    for (int index = 0; index < int(result.pointers.size()); ++index)
+    {
+        const stage_section *section = result.pointers[index];
+        result.events.push_back(
+            {section->starting_pos(), stage_event_type::SPAWN, index});
+        result.events.push_back(
+            {section->ending_pos(), stage_event_type::DESPAWN, index});
+    }
+
+    std::stable_sort(result.events.begin(), result.events.end(),
+                     [](const stage_event &a, const stage_event &b) {
+                         if (a.position != b.position)
+                         {
+                             return a.position > b.position;
+                         }
+
+                         return a.type == stage_event_type::DESPAWN &&
+                                b.type == stage_event_type::SPAWN;
+                     });
+    return result;
+}
+
+// Indexes of the sections with camera_y <= starting_pos() and
+// camera_y > ending_pos():
+[[nodiscard]] std::set<int> reference_spawned_sections(const stage &stage,
+                                                       int camera_y)
+{
+    std::set<int> result;
+
+    for (int index = 0; index < int(stage.pointers.size()); ++index)
+    {
+        const stage_section *section = stage.pointers[index];
+
+        if (camera_y <= section->starting_pos() &&
+            camera_y > section->ending_pos())
+        {
+            result.insert(index);
+        }
+    }
+
+    return result;
+}
+
+// Moves the camera by the given steps, spawning and despawning sections like
+// enemy_manager does. Returns false if the spawned sections are ever wrong:
+[[nodiscard]] bool follow_camera(const stage &stage, std::mt19937 &random,
+                                 int min_step, int max_step)
+{
+    std::uniform_int_distribution<int> step(min_step, max_step);
+    stage_event_cursor cursor;
+    bn::span<const stage_event> events(stage.events.data(),
+                                       int(stage.events.size()));
+    std::set<int> spawned_sections;
+    int spawns_count = 0;
+
+    for (int camera_y = 20; camera_y > -4000; camera_y -= step(random))
+    {
+        while (const stage_event *event =
+                   cursor.next(events, stage.pointers.data(), camera_y))
+        {
+            if (event->type == stage_event_type::SPAWN)
+            {
+                // Sections are spawned once:
+                if (!spawned_sections.insert(event->section_index).second)
+                {
+                    return false;
+                }
+
+                ++spawns_count;
+            }
+            else
+            {
+                spawned_sections.erase(event->section_index);
+            }
+        }
+
+        if (spawned_sections != reference_spawned_sections(stage, camera_y))
+        {
+            return false;
+        }
+    }
+
+    return spawns_count <= int(stage.pointers.size());
+}
+} // namespace
+
+HOST_TEST(cursor_spawns_the_sections_the_camera_is_in)
+{
+    std::mt19937 random(1234);
+
+    for (int stage_index = 0; stage_index < 100; ++stage_index)
+    {
+        stage stage = random_stage(random);
+
+        if (!follow_camera(stage, random, 1, 8))
+        {
+            CHECK(false);
+            return;
+        }
+    }
+}
+
+HOST_TEST(cursor_skips_the_sections_passed_between_updates)
+{
+    std::mt19937 random(5678);
+
+    for (int stage_index = 0; stage_index < 100; ++stage_index)
+    {
+        stage stage = random_stage(random);
+
+        if (!follow_camera(stage, random, 50, 400))
+        {
+            CHECK(false);
+            return;
+        }
+    }
+}
+
+HOST_TEST(cursor_consumes_each_event_once)
+{
+    std::mt19937 random(9012);
+    stage stage = random_stage(random);
+    stage_event_cursor cursor;
+    bn::span<const stage_event> events(stage.events.data(),
+                                       int(stage.events.size()));
+    int despawns_count = 0;
+
+    // Spawns can be skipped, but every section is despawned once:
+    for (int camera_y = 20; camera_y > -4000; --camera_y)
+    {
+        while (const stage_event *event =
+                   cursor.next(events, stage.pointers.data(), camera_y))
+        {
+            CHECK(camera_y <= event->position);
+            despawns_count += event->type == stage_event_type::DESPAWN;
+        }
+    }
+
+    CHECK_EQUAL(despawns_count, int(stage.pointers.size()));
+    CHECK(cursor.next(events, stage.pointers.data(), -5000) == nullptr);
+}
@@ -0,0 +1,249 @@
+/*
+ * Tests of the section cursors of stage_section_index.
+ */
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "bn_assert.h"
+
+#include "stage_section_index.h"
+
+#include "host_test.h"
+
+namespace
+{
+// Sections with camera_position <= starting_pos() and
+// camera_position > ending_pos(), sorted by starting position:
+[[nodiscard]] std::vector<const stage_section *> reference_active_sections(
+    const std::vector<const stage_section *> &sections, int camera_position)
+{
+    std::vector<const stage_section *> result;
+
+    for (const stage_section *section : sections)
+    {
+        if (camera_position <= section->starting_pos() &&
+            camera_position > section->ending_pos())
+        {
+            auto it = result.begin();
+
+            while (it != result.end() &&
+                   (*it)->starting_pos() >= section->starting_pos())
+            {
+                ++it;
+            }
+
+            result.insert(it, section);
+        }
+    }
+
+    return result;
+}
+
+[[nodiscard]] bool same_active_sections(
+    const stage_section_index &index,
+    const std::vector<const stage_section *> &expected)
+{
+    bn::span<const stage_section *const> actual = index.active_sections();
+
+    if (int(expected.size()) != actual.size())
+    {
+        return false;
+    }
+
+    for (int position = 0; position < actual.size(); ++position)
+    {
+        if (actual[position]->starting_pos() !=
+            expected[position]->starting_pos())
+        {
+            return false;
+        }
+    }
+
+    for (const stage_section *section : expected)
+    {
+        bool found = false;
+
+        for (const stage_section *active_section : actual)
+        {
+            found |= active_section == section;
+        }
+
+        if (!found)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Random overlapping sections along -Y, at most max_overlap of them at once:
+[[nodiscard]] std::vector<stage_section> random_sections(std::mt19937 &random,
+                                                         int max_overlap)
+{
+    std::uniform_int_distribution<int> gap(0, 40);
+    std::uniform_int_distribution<int> length(1, 300);
+    std::vector<stage_section> result;
+    int starting_pos = 0;
+
+    while (int(result.size()) < stage_section_index::max_sections)
+    {
+        int ending_pos = starting_pos - length(random);
+        int overlap = 0;
+
+        for (const stage_section &section : result)
+        {
+            overlap += section.ending_pos() < starting_pos;
+        }
+
+        if (overlap < max_overlap)
+        {
+            result.emplace_back(starting_pos, ending_pos,
+                                std::initializer_list<fr::model_3d_item>{},
+                                std::initializer_list<enemy_def>{});
+        }
+
+        starting_pos -= gap(random);
+    }
+
+    return result;
+}
+
+[[nodiscard]] std::vector<const stage_section *> shuffled_pointers(
+    std::mt19937 &random, const std::vector<stage_section> &sections)
+{
+    std::vector<const stage_section *> result;
+
+    for (const stage_section &section : sections)
+    {
+        result.push_back(&section);
+    }
+
+    std::shuffle(result.begin(), result.end(), random);
+    return result;
+}
+
+struct assert_failed : std::runtime_error
+{
+    using std::runtime_error::runtime_error;
+};
+
+[[noreturn]] void throw_assert_failed(const std::string &message)
+{
+    throw assert_failed(message);
+}
+} // namespace
+
+HOST_TEST(cursors_follow_the_camera_forward)
+{
+    std::mt19937 random(1234);
+
+    for (int stage = 0; stage < 50; ++stage)
+    {
+        std::vector<stage_section> sections = random_sections(
+            random, stage_section_index::max_active_sections);
+        std::vector<const stage_section *> pointers =
+            shuffled_pointers(random, sections);
+        stage_section_index index(pointers.data(), pointers.size());
+        std::vector<const stage_section *> last_expected;
+
+        for (int camera_position = 20; camera_position > -3000;
+             camera_position -= 3)
+        {
+            bool changed = index.update(camera_position);
+            std::vector<const stage_section *> expected =
+                reference_active_sections(pointers, camera_position);
+
+            // Sections entered and passed in the same update can report a
+            // change too:
+            if (expected != last_expected)
+            {
+                CHECK(changed);
+            }
+
+            if (!same_active_sections(index, expected))
+            {
+                CHECK(same_active_sections(index, expected));
+                return;
+            }
+
+            last_expected = expected;
+        }
+    }
+}
+
+HOST_TEST(cursors_rewind_when_the_camera_moves_back)
+{
+    std::mt19937 random(5678);
+    std::uniform_int_distribution<int> step(-120, 40);
+
+    for (int stage = 0; stage < 50; ++stage)
+    {
+        std::vector<stage_section> sections = random_sections(
+            random, stage_section_index::max_active_sections);
+        std::vector<const stage_section *> pointers =
+            shuffled_pointers(random, sections);
+        stage_section_index index(pointers.data(), pointers.size());
+        int camera_position = 20;
+
+        for (int frame = 0; frame < 200; ++frame)
+        {
+            camera_position += step(random);
+            (void) index.update(camera_position);
+
+            if (!same_active_sections(
+                    index,
+                    reference_active_sections(pointers, camera_position)))
+            {
+                CHECK(false);
+                return;
+            }
+        }
+    }
+}
+
+HOST_TEST(too_many_overlapping_sections_assert)
+{
+    std::vector<stage_section> sections;
+
+    for (int index = 0; index <= stage_section_index::max_active_sections;
+         ++index)
+    {
+        sections.emplace_back(-index, -100,
+                              std::initializer_list<fr::model_3d_item>{},
+                              std::initializer_list<enemy_def>{});
+    }
+
+    std::vector<const stage_section *> pointers;
+
+    for (const stage_section &section : sections)
+    {
+        pointers.push_back(&section);
+    }
+
+    bn::assert::handler_type previous_handler =
+        bn::assert::set_handler(throw_assert_failed);
+    bool failed = false;
+
+    try
+    {
+        stage_section_index index(pointers.data(), pointers.size());
+    }
+    catch (const assert_failed &)
+    {
+        failed = true;
+    }
+
+    bn::assert::set_handler(previous_handler);
+    CHECK(failed);
+
+    // One less fits:
+    pointers.pop_back();
+    stage_section_index index(pointers.data(), pointers.size());
+    CHECK(index.update(-50));
+    CHECK_EQUAL(index.active_sections().size(),
+                stage_section_index::max_active_sections);
+}
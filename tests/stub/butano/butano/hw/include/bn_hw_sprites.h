@@ -0,0 +1,92 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ *
+ * OAM is an array in host memory.
+ */
+
+#ifndef BN_HW_SPRITES_H
+#define BN_HW_SPRITES_H
+
+#include "bn_bpp_mode.h"
+#include "bn_sprite_shape_size.h"
+
+#define ATTR0_Y_MASK 0x00FF
+#define ATTR0_REG 0x0000
+#define ATTR0_AFF 0x0100
+#define ATTR0_HIDE 0x0200
+#define ATTR0_AFF_DBL 0x0300
+#define ATTR0_MODE_MASK 0x0300
+#define ATTR0_BLEND 0x0400
+#define ATTR0_WINDOW 0x0800
+#define ATTR0_MOSAIC 0x1000
+#define ATTR0_8BPP 0x2000
+
+#define ATTR1_X_MASK 0x01FF
+#define ATTR1_AFF_ID_SHIFT 9
+#define ATTR1_HFLIP 0x1000
+#define ATTR1_VFLIP 0x2000
+
+#define ATTR2_ID_MASK 0x03FF
+#define ATTR2_PRIO_SHIFT 10
+#define ATTR2_PALBANK_SHIFT 12
+
+namespace bn::hw::sprites
+{
+struct handle
+{
+    uint16_t attr0;
+    uint16_t attr1;
+    uint16_t attr2;
+    int16_t fill;
+};
+
+[[nodiscard]] constexpr int count()
+{
+    return 128;
+}
+
+[[nodiscard]] handle *vram();
+
+[[nodiscard]] constexpr int first_attributes(int y, sprite_shape shape,
+                                             bpp_mode bpp, int affine_mode,
+                                             bool mosaic_enabled,
+                                             bool blending_enabled,
+                                             bool window_enabled,
+                                             bool fade_enabled)
+{
+    return (y & ATTR0_Y_MASK) | affine_mode |
+           (mosaic_enabled ? ATTR0_MOSAIC : 0) |
+           (blending_enabled || fade_enabled ? ATTR0_BLEND : 0) |
+           (window_enabled ? ATTR0_WINDOW : 0) |
+           (bpp == bpp_mode::BPP_8 ? ATTR0_8BPP : 0) | (int(shape) << 14);
+}
+
+[[nodiscard]] constexpr int second_attributes(int x, sprite_size size,
+                                              bool horizontal_flip,
+                                              bool vertical_flip)
+{
+    return (x & ATTR1_X_MASK) | (horizontal_flip ? ATTR1_HFLIP : 0) |
+           (vertical_flip ? ATTR1_VFLIP : 0) | (int(size) << 14);
+}
+
+[[nodiscard]] constexpr int second_attributes(int x, sprite_size size,
+                                              int affine_mat_id)
+{
+    return (x & ATTR1_X_MASK) | (affine_mat_id << ATTR1_AFF_ID_SHIFT) |
+           (int(size) << 14);
+}
+
+[[nodiscard]] constexpr int third_attributes(int tiles_id, int palette_id,
+                                             int bg_priority)
+{
+    return tiles_id | (bg_priority << ATTR2_PRIO_SHIFT) |
+           (palette_id << ATTR2_PALBANK_SHIFT);
+}
+
+inline void hide_and_destroy(uint16_t &attr0)
+{
+    attr0 = ATTR0_HIDE;
+}
+} // namespace bn::hw::sprites
+
+#endif
@@ -0,0 +1,24 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_ALGORITHM_H
+#define BN_ALGORITHM_H
+
+#include <algorithm>
+
+#include "bn_utility.h"
+
+namespace bn
+{
+using std::clamp;
+using std::copy;
+using std::fill;
+using std::find;
+using std::max;
+using std::min;
+using std::sort;
+using std::stable_sort;
+} // namespace bn
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ *
+ * Like in Butano, the elements are stored in a public _data member.
+ */
+
+#ifndef BN_ARRAY_H
+#define BN_ARRAY_H
+
+#include "bn_common.h"
+
+namespace bn
+{
+template <typename Type, int Size> class array
+{
+  public:
+    using value_type = Type;
+    using size_type = int;
+    using iterator = Type *;
+    using const_iterator = const Type *;
+
+    Type _data[Size > 0 ? Size : 1];
+
+    [[nodiscard]] constexpr const Type *data() const
+    {
+        return _data;
+    }
+
+    [[nodiscard]] constexpr Type *data()
+    {
+        return _data;
+    }
+
+    [[nodiscard]] static constexpr int size()
+    {
+        return Size;
+    }
+
+    [[nodiscard]] static constexpr int max_size()
+    {
+        return Size;
+    }
+
+    [[nodiscard]] static constexpr bool empty()
+    {
+        return Size == 0;
+    }
+
+    [[nodiscard]] constexpr const Type *begin() const
+    {
+        return _data;
+    }
+
+    [[nodiscard]] constexpr Type *begin()
+    {
+        return _data;
+    }
+
+    [[nodiscard]] constexpr const Type *end() const
+    {
+        return _data + Size;
+    }
+
+    [[nodiscard]] constexpr Type *end()
+    {
+        return _data + Size;
+    }
+
+    [[nodiscard]] constexpr const Type *cbegin() const
+    {
+        return _data;
+    }
+
+    [[nodiscard]] constexpr const Type *cend() const
+    {
+        return _data + Size;
+    }
+
+    [[nodiscard]] constexpr const Type &operator[](int index) const
+    {
+        BN_ASSERT(index >= 0 && index < Size, "Invalid index: ", index);
+        return _data[index];
+    }
+
+    [[nodiscard]] constexpr Type &operator[](int index)
+    {
+        BN_ASSERT(index >= 0 && index < Size, "Invalid index: ", index);
+        return _data[index];
+    }
+
+    [[nodiscard]] constexpr const Type &front() const
+    {
+        return _data[0];
+    }
+
+    [[nodiscard]] constexpr Type &front()
+    {
+        return _data[0];
+    }
+
+    [[nodiscard]] constexpr const Type &back() const
+    {
+        return _data[Size - 1];
+    }
+
+    [[nodiscard]] constexpr Type &back()
+    {
+        return _data[Size - 1];
+    }
+
+    constexpr void fill(const Type &value)
+    {
+        for (Type &element : _data)
+        {
+            element = value;
+        }
+    }
+
+    [[nodiscard]] constexpr friend bool operator==(const array &a,
+                                                   const array &b)
+    {
+        for (int index = 0; index < Size; ++index)
+        {
+            if (!(a._data[index] == b._data[index]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+} // namespace bn
+
+#endif
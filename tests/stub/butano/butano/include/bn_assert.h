@@ -0,0 +1,57 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ *
+ * Failed assertions call the installed handler, which aborts by default.
+ * Tests can install a handler which throws to check that an assertion fails.
+ */
+
+#ifndef BN_ASSERT_H
+#define BN_ASSERT_H
+
+#include <sstream>
+#include <string>
+
+namespace bn::assert
+{
+using handler_type = void (*)(const std::string &message);
+
+// Returns the previous handler:
+handler_type set_handler(handler_type handler);
+
+[[noreturn]] void fail(const std::string &message);
+
+template <typename... Args>
+[[noreturn]] void show(const char *condition, const char *file, int line,
+                       const Args &...args)
+{
+    std::ostringstream stream;
+    stream << file << ':' << line << ": " << condition;
+
+    if constexpr (sizeof...(args) > 0)
+    {
+        stream << ": ";
+        (stream << ... << args);
+    }
+
+    fail(stream.str());
+}
+} // namespace bn::assert
+
+#define BN_ASSERT(condition, ...)                                              \
+    do                                                                         \
+    {                                                                          \
+        if (!(condition)) [[unlikely]]                                         \
+        {                                                                      \
+            bn::assert::show(#condition, __FILE__,                             \
+                             __LINE__ __VA_OPT__(, ) __VA_ARGS__);             \
+        }                                                                      \
+    } while (false)
+
+#define BN_ERROR(...)                                                          \
+    do                                                                         \
+    {                                                                          \
+        bn::assert::show("error", __FILE__, __LINE__ __VA_OPT__(, )           \
+                                                __VA_ARGS__);                  \
+    } while (false)
+
+#endif
@@ -0,0 +1,19 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_BPP_MODE_H
+#define BN_BPP_MODE_H
+
+#include "bn_common.h"
+
+namespace bn
+{
+enum class bpp_mode : uint8_t
+{
+    BPP_4,
+    BPP_8
+};
+}
+
+#endif
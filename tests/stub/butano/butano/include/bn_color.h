@@ -0,0 +1,57 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_COLOR_H
+#define BN_COLOR_H
+
+#include "bn_common.h"
+
+namespace bn
+{
+class color
+{
+  public:
+    constexpr color() = default;
+
+    constexpr explicit color(int data) : _data(uint16_t(data))
+    {
+        BN_ASSERT(data >= 0 && data <= 0x7FFF, "Invalid data: ", data);
+    }
+
+    constexpr color(int red, int green, int blue)
+        : _data(uint16_t(red + (green << 5) + (blue << 10)))
+    {
+        BN_ASSERT(red >= 0 && red <= 31, "Invalid red: ", red);
+        BN_ASSERT(green >= 0 && green <= 31, "Invalid green: ", green);
+        BN_ASSERT(blue >= 0 && blue <= 31, "Invalid blue: ", blue);
+    }
+
+    [[nodiscard]] constexpr int data() const
+    {
+        return _data;
+    }
+
+    [[nodiscard]] constexpr int red() const
+    {
+        return _data & 31;
+    }
+
+    [[nodiscard]] constexpr int green() const
+    {
+        return (_data >> 5) & 31;
+    }
+
+    [[nodiscard]] constexpr int blue() const
+    {
+        return (_data >> 10) & 31;
+    }
+
+    [[nodiscard]] constexpr friend bool operator==(color a, color b) = default;
+
+  private:
+    uint16_t _data = 0;
+};
+} // namespace bn
+
+#endif
@@ -0,0 +1,31 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_COLORS_H
+#define BN_COLORS_H
+
+#include "bn_color.h"
+
+namespace bn::colors
+{
+constexpr color black(0, 0, 0);
+constexpr color white(31, 31, 31);
+constexpr color gray(16, 16, 16);
+constexpr color red(31, 0, 0);
+constexpr color green(0, 31, 0);
+constexpr color blue(0, 0, 31);
+constexpr color yellow(31, 31, 0);
+constexpr color magenta(31, 0, 31);
+constexpr color cyan(0, 31, 31);
+constexpr color orange(31, 16, 0);
+constexpr color maroon(16, 0, 0);
+constexpr color navy(0, 0, 16);
+constexpr color olive(16, 16, 0);
+constexpr color purple(16, 0, 16);
+constexpr color silver(24, 24, 24);
+constexpr color teal(0, 16, 16);
+constexpr color lime(0, 31, 0);
+} // namespace bn::colors
+
+#endif
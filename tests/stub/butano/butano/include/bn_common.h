@@ -0,0 +1,21 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_COMMON_H
+#define BN_COMMON_H
+
+#include <cstddef>
+#include <cstdint>
+
+#define BN_CODE_IWRAM
+#define BN_CODE_EWRAM
+#define BN_DATA_EWRAM
+#define BN_DATA_EWRAM_BSS
+
+#define BN_CFG_ASSERT_ENABLED true
+#define BN_CFG_LOG_ENABLED true
+
+#include "bn_assert.h"
+
+#endif
@@ -0,0 +1,23 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_DISPLAY_H
+#define BN_DISPLAY_H
+
+#include "bn_common.h"
+
+namespace bn::display
+{
+[[nodiscard]] constexpr int width()
+{
+    return 240;
+}
+
+[[nodiscard]] constexpr int height()
+{
+    return 160;
+}
+} // namespace bn::display
+
+#endif
@@ -0,0 +1,300 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ *
+ * Multiplications wrap around like the ARM mul instruction instead of
+ * overflowing.
+ */
+
+#ifndef BN_FIXED_H
+#define BN_FIXED_H
+
+#include <compare>
+#include <ostream>
+
+#include "bn_common.h"
+
+namespace bn
+{
+template <int Precision> class fixed_t
+{
+    static_assert(Precision >= 0 && Precision <= 31, "Invalid precision");
+
+  public:
+    [[nodiscard]] static constexpr int precision()
+    {
+        return Precision;
+    }
+
+    [[nodiscard]] static constexpr int scale()
+    {
+        return 1 << Precision;
+    }
+
+    [[nodiscard]] static constexpr fixed_t from_data(int data)
+    {
+        fixed_t result;
+        result._data = data;
+        return result;
+    }
+
+    constexpr fixed_t() = default;
+
+    constexpr fixed_t(int value) : _data(_wrap(unsigned(value) << Precision))
+    {
+    }
+
+    constexpr fixed_t(unsigned value) : _data(_wrap(value << Precision))
+    {
+    }
+
+    constexpr fixed_t(float value) : _data(int(value * scale()))
+    {
+    }
+
+    constexpr fixed_t(double value) : _data(int(value * scale()))
+    {
+    }
+
+    template <int OtherPrecision>
+    constexpr fixed_t(fixed_t<OtherPrecision> other)
+        : _data(Precision >= OtherPrecision
+                    ? _wrap(unsigned(other.data())
+                            << (Precision - OtherPrecision))
+                    : other.data() >> (OtherPrecision - Precision))
+    {
+    }
+
+    [[nodiscard]] constexpr int data() const
+    {
+        return _data;
+    }
+
+    constexpr void set_data(int data)
+    {
+        _data = data;
+    }
+
+    [[nodiscard]] constexpr int integer() const
+    {
+        return _data / scale();
+    }
+
+    [[nodiscard]] constexpr int right_shift_integer() const
+    {
+        return _data >> Precision;
+    }
+
+    [[nodiscard]] constexpr int floor_integer() const
+    {
+        return _data >> Precision;
+    }
+
+    [[nodiscard]] constexpr int round_integer() const
+    {
+        return int((int64_t(_data) + (scale() / 2)) >> Precision);
+    }
+
+    [[nodiscard]] constexpr int ceil_integer() const
+    {
+        return int((int64_t(_data) + scale() - 1) >> Precision);
+    }
+
+    [[nodiscard]] constexpr int unsigned_integer() const
+    {
+        return int(unsigned(_data) >> Precision);
+    }
+
+    [[nodiscard]] constexpr double to_double() const
+    {
+        return double(_data) / scale();
+    }
+
+    [[nodiscard]] constexpr fixed_t fraction() const
+    {
+        return from_data(_data & (scale() - 1));
+    }
+
+    [[nodiscard]] constexpr fixed_t multiplication(int value) const
+    {
+        return from_data(_wrap(unsigned(_data) * unsigned(value)));
+    }
+
+    [[nodiscard]] constexpr fixed_t multiplication(fixed_t other) const
+    {
+        return from_data(int((int64_t(_data) * other._data) >> Precision));
+    }
+
+    [[nodiscard]] constexpr fixed_t safe_multiplication(fixed_t other) const
+    {
+        return from_data(_wrap(unsigned(_data >> (Precision / 2)) *
+                               unsigned(other._data >> (Precision / 2))));
+    }
+
+    [[nodiscard]] constexpr fixed_t unsafe_multiplication(fixed_t other) const
+    {
+        return from_data(_wrap(unsigned(_data) * unsigned(other._data)) >>
+                         Precision);
+    }
+
+    [[nodiscard]] constexpr fixed_t division(int value) const
+    {
+        return from_data(_data / value);
+    }
+
+    [[nodiscard]] constexpr fixed_t division(fixed_t other) const
+    {
+        return from_data(int((int64_t(_data) << Precision) / other._data));
+    }
+
+    [[nodiscard]] constexpr fixed_t safe_division(fixed_t other) const
+    {
+        return division(other);
+    }
+
+    [[nodiscard]] constexpr fixed_t unsafe_division(fixed_t other) const
+    {
+        return from_data(_wrap(unsigned(_data) << Precision) / other._data);
+    }
+
+    [[nodiscard]] constexpr fixed_t operator-() const
+    {
+        return from_data(_wrap(0u - unsigned(_data)));
+    }
+
+    constexpr fixed_t &operator+=(fixed_t other)
+    {
+        _data = _wrap(unsigned(_data) + unsigned(other._data));
+        return *this;
+    }
+
+    constexpr fixed_t &operator-=(fixed_t other)
+    {
+        _data = _wrap(unsigned(_data) - unsigned(other._data));
+        return *this;
+    }
+
+    constexpr fixed_t &operator*=(int value)
+    {
+        *this = multiplication(value);
+        return *this;
+    }
+
+    constexpr fixed_t &operator*=(unsigned value)
+    {
+        *this = multiplication(int(value));
+        return *this;
+    }
+
+    constexpr fixed_t &operator*=(fixed_t other)
+    {
+        *this = multiplication(other);
+        return *this;
+    }
+
+    constexpr fixed_t &operator/=(int value)
+    {
+        *this = division(value);
+        return *this;
+    }
+
+    constexpr fixed_t &operator/=(unsigned value)
+    {
+        *this = division(int(value));
+        return *this;
+    }
+
+    constexpr fixed_t &operator/=(fixed_t other)
+    {
+        *this = division(other);
+        return *this;
+    }
+
+    constexpr fixed_t &operator<<=(int shift)
+    {
+        _data = _wrap(unsigned(_data) << shift);
+        return *this;
+    }
+
+    constexpr fixed_t &operator>>=(int shift)
+    {
+        _data >>= shift;
+        return *this;
+    }
+
+    [[nodiscard]] constexpr friend fixed_t operator+(fixed_t a, fixed_t b)
+    {
+        return a += b;
+    }
+
+    [[nodiscard]] constexpr friend fixed_t operator-(fixed_t a, fixed_t b)
+    {
+        return a -= b;
+    }
+
+    [[nodiscard]] constexpr friend fixed_t operator*(fixed_t a, int b)
+    {
+        return a.multiplication(b);
+    }
+
+    [[nodiscard]] constexpr friend fixed_t operator*(fixed_t a, unsigned b)
+    {
+        return a.multiplication(int(b));
+    }
+
+    [[nodiscard]] constexpr friend fixed_t operator*(fixed_t a, fixed_t b)
+    {
+        return a.multiplication(b);
+    }
+
+    [[nodiscard]] constexpr friend fixed_t operator/(fixed_t a, int b)
+    {
+        return a.division(b);
+    }
+
+    [[nodiscard]] constexpr friend fixed_t operator/(fixed_t a, unsigned b)
+    {
+        return a.division(int(b));
+    }
+
+    [[nodiscard]] constexpr friend fixed_t operator/(fixed_t a, fixed_t b)
+    {
+        return a.division(b);
+    }
+
+    [[nodiscard]] constexpr friend fixed_t operator<<(fixed_t a, int shift)
+    {
+        return a <<= shift;
+    }
+
+    [[nodiscard]] constexpr friend fixed_t operator>>(fixed_t a, int shift)
+    {
+        return a >>= shift;
+    }
+
+    [[nodiscard]] constexpr friend bool operator==(fixed_t a,
+                                                   fixed_t b) = default;
+
+    [[nodiscard]] constexpr friend std::strong_ordering operator<=>(fixed_t a,
+                                                                    fixed_t b)
+    {
+        return a._data <=> b._data;
+    }
+
+    friend std::ostream &operator<<(std::ostream &stream, fixed_t value)
+    {
+        return stream << (double(value._data) / scale());
+    }
+
+  private:
+    int _data = 0;
+
+    [[nodiscard]] static constexpr int _wrap(unsigned value)
+    {
+        return int(value);
+    }
+};
+
+using fixed = fixed_t<12>;
+} // namespace bn
+
+#endif
@@ -0,0 +1,21 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ *
+ * Transfers aren't done by this stub: see bn_host.h.
+ */
+
+#ifndef BN_HDMA_H
+#define BN_HDMA_H
+
+#include "bn_common.h"
+
+namespace bn::hdma
+{
+[[nodiscard]] bool running();
+
+void start(const uint16_t &source_ref, int elements, uint16_t &destination_ref);
+
+void stop();
+} // namespace bn::hdma
+
+#endif
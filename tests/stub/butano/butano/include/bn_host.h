@@ -0,0 +1,70 @@
+/*
+ * Host only extension of the Butano stub, see tests/CMakeLists.txt.
+ *
+ * Gives access to the emulated hardware state, so it can be rasterized and
+ * checked by host programs.
+ */
+
+#ifndef BN_HOST_H
+#define BN_HOST_H
+
+#include <string>
+#include <vector>
+
+#include "bn_color.h"
+#include "bn_fixed.h"
+#include "bn_sprite_tiles_item.h"
+
+namespace bn::host
+{
+struct hdma_transfer
+{
+    const uint16_t *source;
+    int elements;
+    uint16_t *destination;
+};
+
+struct tiles_entry
+{
+    const sprite_tiles_item *item;
+    int graphics_index;
+};
+
+struct palette_entry
+{
+    color colors[16];
+    color fade_color;
+    fixed fade_intensity;
+};
+
+struct affine_mat_entry
+{
+    fixed scale = 1;
+    fixed rotation_angle;
+};
+
+struct profiler_entry
+{
+    std::string id;
+    long long total_nanoseconds;
+    int calls;
+};
+
+// Running HDMA transfer, or nullptr if there's none. Like on the GBA, the
+// transfer i is done in the horizontal blank after screen line i, and the
+// last one is kept in OAM during the vertical blank:
+[[nodiscard]] const hdma_transfer *hdma();
+
+// Tiles which start in the given tiles id, or nullptr if there's none:
+[[nodiscard]] const tiles_entry *tiles(int tiles_id);
+
+// Allocated palette with the given id, or nullptr if there's none:
+[[nodiscard]] const palette_entry *palette(int palette_id);
+
+// Allocated affine matrix with the given id, or nullptr if there's none:
+[[nodiscard]] const affine_mat_entry *affine_mat(int affine_mat_id);
+
+[[nodiscard]] std::vector<profiler_entry> profiler_entries();
+} // namespace bn::host
+
+#endif
@@ -0,0 +1,155 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_INTRUSIVE_LIST_H
+#define BN_INTRUSIVE_LIST_H
+
+#include "bn_common.h"
+
+namespace bn
+{
+class intrusive_list_node_type
+{
+  public:
+    intrusive_list_node_type *prev = nullptr;
+    intrusive_list_node_type *next = nullptr;
+};
+
+template <typename Type> class intrusive_list
+{
+  public:
+    template <typename Value> class basic_iterator
+    {
+      public:
+        explicit basic_iterator(intrusive_list_node_type *node) : _node(node)
+        {
+        }
+
+        Value &operator*() const
+        {
+            return static_cast<Value &>(*_node);
+        }
+
+        Value *operator->() const
+        {
+            return static_cast<Value *>(_node);
+        }
+
+        basic_iterator &operator++()
+        {
+            _node = _node->next;
+            return *this;
+        }
+
+        basic_iterator &operator--()
+        {
+            _node = _node->prev;
+            return *this;
+        }
+
+        friend bool operator==(const basic_iterator &a,
+                               const basic_iterator &b) = default;
+
+      private:
+        intrusive_list_node_type *_node;
+    };
+
+    using iterator = basic_iterator<Type>;
+    using const_iterator = basic_iterator<const Type>;
+
+    intrusive_list()
+    {
+        _sentinel.prev = &_sentinel;
+        _sentinel.next = &_sentinel;
+    }
+
+    intrusive_list(const intrusive_list &other) = delete;
+
+    intrusive_list &operator=(const intrusive_list &other) = delete;
+
+    [[nodiscard]] int size() const
+    {
+        return _size;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return !_size;
+    }
+
+    [[nodiscard]] iterator begin()
+    {
+        return iterator(_sentinel.next);
+    }
+
+    [[nodiscard]] iterator end()
+    {
+        return iterator(&_sentinel);
+    }
+
+    [[nodiscard]] const_iterator begin() const
+    {
+        return const_iterator(_sentinel.next);
+    }
+
+    [[nodiscard]] const_iterator end() const
+    {
+        return const_iterator(const_cast<intrusive_list_node_type *>(&_sentinel));
+    }
+
+    [[nodiscard]] Type &front()
+    {
+        return static_cast<Type &>(*_sentinel.next);
+    }
+
+    [[nodiscard]] Type &back()
+    {
+        return static_cast<Type &>(*_sentinel.prev);
+    }
+
+    void push_front(Type &value)
+    {
+        _insert(_sentinel.next, value);
+    }
+
+    void push_back(Type &value)
+    {
+        _insert(&_sentinel, value);
+    }
+
+    void erase(Type &value)
+    {
+        intrusive_list_node_type &node = value;
+        node.prev->next = node.next;
+        node.next->prev = node.prev;
+        node.prev = nullptr;
+        node.next = nullptr;
+        --_size;
+    }
+
+    void clear()
+    {
+        while (_size)
+        {
+            erase(front());
+        }
+    }
+
+  private:
+    intrusive_list_node_type _sentinel;
+    int _size = 0;
+
+    void _insert(intrusive_list_node_type *position, Type &value)
+    {
+        intrusive_list_node_type &node = value;
+        node.prev = position->prev;
+        node.next = position;
+        position->prev->next = &node;
+        position->prev = &node;
+        ++_size;
+    }
+};
+} // namespace bn
+
+#endif
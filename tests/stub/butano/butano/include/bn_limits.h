@@ -0,0 +1,15 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_LIMITS_H
+#define BN_LIMITS_H
+
+#include <limits>
+
+namespace bn
+{
+using std::numeric_limits;
+}
+
+#endif
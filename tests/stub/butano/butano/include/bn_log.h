@@ -0,0 +1,27 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ *
+ * Messages are written to stderr.
+ */
+
+#ifndef BN_LOG_H
+#define BN_LOG_H
+
+#include <iostream>
+#include <sstream>
+
+#include "bn_common.h"
+
+namespace bn::log
+{
+template <typename... Args> void print(const Args &...args)
+{
+    std::ostringstream stream;
+    (stream << ... << args);
+    std::cerr << stream.str() << '\n';
+}
+} // namespace bn::log
+
+#define BN_LOG(...) bn::log::print(__VA_ARGS__)
+
+#endif
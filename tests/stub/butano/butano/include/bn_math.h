@@ -0,0 +1,58 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_MATH_H
+#define BN_MATH_H
+
+#include "bn_algorithm.h"
+#include "bn_fixed.h"
+
+namespace bn
+{
+template <typename Type> [[nodiscard]] constexpr Type abs(Type value)
+{
+    return value < 0 ? -value : value;
+}
+
+// Integer square root, rounded down:
+[[nodiscard]] constexpr int sqrt(int value)
+{
+    BN_ASSERT(value >= 0, "Invalid value: ", value);
+
+    unsigned result = 0;
+    unsigned bit = 1u << 30;
+    auto remainder = unsigned(value);
+
+    while (bit > remainder)
+    {
+        bit >>= 2;
+    }
+
+    while (bit)
+    {
+        if (remainder >= result + bit)
+        {
+            remainder -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return int(result);
+}
+
+template <int Precision>
+[[nodiscard]] constexpr fixed_t<Precision> sqrt(fixed_t<Precision> value)
+{
+    return fixed_t<Precision>::from_data(sqrt(value.data())
+                                         << (Precision / 2));
+}
+} // namespace bn
+
+#endif
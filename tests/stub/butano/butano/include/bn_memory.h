@@ -0,0 +1,35 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_MEMORY_H
+#define BN_MEMORY_H
+
+#include <cstring>
+
+#include "bn_common.h"
+
+namespace bn::memory
+{
+template <typename Type>
+void copy(const Type &source_ref, int elements, Type &destination_ref)
+{
+    BN_ASSERT(elements >= 0, "Invalid elements: ", elements);
+    std::memmove(&destination_ref, &source_ref, size_t(elements) * sizeof(Type));
+}
+
+template <typename Type> void clear(int elements, Type &destination_ref)
+{
+    BN_ASSERT(elements >= 0, "Invalid elements: ", elements);
+    std::memset(&destination_ref, 0, size_t(elements) * sizeof(Type));
+}
+
+template <typename Type>
+void set(int elements, uint8_t value, Type &destination_ref)
+{
+    BN_ASSERT(elements >= 0, "Invalid elements: ", elements);
+    std::memset(&destination_ref, value, size_t(elements) * sizeof(Type));
+}
+} // namespace bn::memory
+
+#endif
@@ -0,0 +1,16 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_OPTIONAL_H
+#define BN_OPTIONAL_H
+
+#include <optional>
+
+namespace bn
+{
+using std::nullopt;
+using std::optional;
+} // namespace bn
+
+#endif
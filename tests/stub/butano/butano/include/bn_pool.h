@@ -0,0 +1,88 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_POOL_H
+#define BN_POOL_H
+
+#include <new>
+
+#include "bn_utility.h"
+
+namespace bn
+{
+template <typename Type, int MaxSize> class pool
+{
+    static_assert(MaxSize > 0, "Invalid max size");
+
+  public:
+    pool()
+    {
+        for (int index = 0; index < MaxSize; ++index)
+        {
+            _free_indexes[index] = MaxSize - index - 1;
+        }
+    }
+
+    pool(const pool &other) = delete;
+
+    pool &operator=(const pool &other) = delete;
+
+    ~pool()
+    {
+        BN_ASSERT(empty(), "Pool is not empty");
+    }
+
+    [[nodiscard]] int size() const
+    {
+        return MaxSize - _free_count;
+    }
+
+    [[nodiscard]] static constexpr int max_size()
+    {
+        return MaxSize;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return _free_count == MaxSize;
+    }
+
+    [[nodiscard]] bool full() const
+    {
+        return !_free_count;
+    }
+
+    template <typename... Args> [[nodiscard]] Type &create(Args &&...args)
+    {
+        BN_ASSERT(!full(), "Pool is full");
+
+        --_free_count;
+
+        int index = _free_indexes[_free_count];
+        return *::new (_element(index)) Type(forward<Args>(args)...);
+    }
+
+    void destroy(Type &value)
+    {
+        auto index = int(&value - _element(0));
+        BN_ASSERT(index >= 0 && index < MaxSize, "Value is not in the pool");
+
+        value.~Type();
+        _free_indexes[_free_count] = index;
+        ++_free_count;
+    }
+
+  private:
+    alignas(Type) unsigned char _storage[sizeof(Type) * MaxSize];
+    int _free_indexes[MaxSize];
+    int _free_count = MaxSize;
+
+    [[nodiscard]] Type *_element(int index)
+    {
+        return reinterpret_cast<Type *>(_storage) + index;
+    }
+};
+} // namespace bn
+
+#endif
@@ -0,0 +1,25 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ *
+ * Entries keep the total nanoseconds spent between their start and stop
+ * calls, see bn_host.h.
+ */
+
+#ifndef BN_PROFILER_H
+#define BN_PROFILER_H
+
+#include "bn_common.h"
+
+namespace bn::profiler
+{
+void start(const char *id);
+
+void stop();
+
+void reset();
+} // namespace bn::profiler
+
+#define BN_PROFILER_START(id) bn::profiler::start(id)
+#define BN_PROFILER_STOP() bn::profiler::stop()
+
+#endif
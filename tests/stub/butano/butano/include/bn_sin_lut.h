@@ -0,0 +1,41 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_SIN_LUT_H
+#define BN_SIN_LUT_H
+
+#include "bn_common.h"
+
+namespace bn
+{
+// Sine of 2 * pi * lut_angle / 65536, with 12 fractional bits:
+[[nodiscard]] constexpr int calculate_sin_lut_value(int lut_angle)
+{
+    lut_angle &= 0xFFFF;
+
+    bool negative = lut_angle >= 0x8000;
+    lut_angle &= 0x7FFF;
+
+    if (lut_angle > 0x4000)
+    {
+        lut_angle = 0x8000 - lut_angle;
+    }
+
+    double x = lut_angle * (3.14159265358979323846 / 32768);
+    double x2 = x * x;
+    double term = x;
+    double result = x;
+
+    for (int index = 1; index < 12; ++index)
+    {
+        term *= -x2 / ((2 * index) * (2 * index + 1));
+        result += term;
+    }
+
+    auto value = int((result * 4096) + 0.5);
+    return negative ? -value : value;
+}
+} // namespace bn
+
+#endif
@@ -0,0 +1,10 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_SORT_H
+#define BN_SORT_H
+
+#include "bn_algorithm.h"
+
+#endif
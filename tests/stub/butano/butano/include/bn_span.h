@@ -0,0 +1,163 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_SPAN_H
+#define BN_SPAN_H
+
+#include <concepts>
+#include <type_traits>
+
+#include "bn_common.h"
+
+namespace bn
+{
+template <typename Type> class span
+{
+  public:
+    using value_type = std::remove_const_t<Type>;
+    using pointer = Type *;
+    using reference = Type &;
+    using iterator = Type *;
+    using const_iterator = Type *;
+    using size_type = int;
+
+    constexpr span() = default;
+
+    constexpr span(Type *data, int size) : _data(data), _size(size)
+    {
+        BN_ASSERT(size >= 0 && (data || !size), "Invalid span");
+    }
+
+    constexpr span(Type *first, Type *last)
+        : _data(first), _size(int(last - first))
+    {
+    }
+
+    template <int Size>
+    constexpr span(Type (&array)[Size]) : _data(array), _size(Size)
+    {
+    }
+
+    template <typename Container>
+        requires requires(Container &container) {
+            {
+                container.data()
+            } -> std::convertible_to<Type *>;
+            container.size();
+        }
+    constexpr span(Container &container)
+        : _data(container.data()), _size(int(container.size()))
+    {
+    }
+
+    template <typename OtherType>
+        requires std::is_convertible_v<OtherType (*)[], Type (*)[]>
+    constexpr span(const span<OtherType> &other)
+        : _data(other.data()), _size(other.size())
+    {
+    }
+
+    [[nodiscard]] constexpr Type *data() const
+    {
+        return _data;
+    }
+
+    [[nodiscard]] constexpr int size() const
+    {
+        return _size;
+    }
+
+    [[nodiscard]] constexpr int size_bytes() const
+    {
+        return _size * int(sizeof(Type));
+    }
+
+    [[nodiscard]] constexpr bool empty() const
+    {
+        return !_size;
+    }
+
+    [[nodiscard]] constexpr Type *begin() const
+    {
+        return _data;
+    }
+
+    [[nodiscard]] constexpr Type *end() const
+    {
+        return _data + _size;
+    }
+
+    [[nodiscard]] constexpr Type *cbegin() const
+    {
+        return _data;
+    }
+
+    [[nodiscard]] constexpr Type *cend() const
+    {
+        return _data + _size;
+    }
+
+    [[nodiscard]] constexpr Type &front() const
+    {
+        BN_ASSERT(_size, "Span is empty");
+        return _data[0];
+    }
+
+    [[nodiscard]] constexpr Type &back() const
+    {
+        BN_ASSERT(_size, "Span is empty");
+        return _data[_size - 1];
+    }
+
+    [[nodiscard]] constexpr Type &operator[](int index) const
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index);
+        return _data[index];
+    }
+
+    [[nodiscard]] constexpr span first(int count) const
+    {
+        BN_ASSERT(count >= 0 && count <= _size, "Invalid count: ", count);
+        return span(_data, count);
+    }
+
+    [[nodiscard]] constexpr span last(int count) const
+    {
+        BN_ASSERT(count >= 0 && count <= _size, "Invalid count: ", count);
+        return span(_data + _size - count, count);
+    }
+
+    [[nodiscard]] constexpr span subspan(int offset, int count) const
+    {
+        BN_ASSERT(offset >= 0 && count >= 0 && offset + count <= _size,
+                  "Invalid subspan: ", offset, " - ", count);
+        return span(_data + offset, count);
+    }
+
+    [[nodiscard]] constexpr friend bool operator==(const span &a,
+                                                   const span &b)
+    {
+        if (a._size != b._size)
+        {
+            return false;
+        }
+
+        for (int index = 0; index < a._size; ++index)
+        {
+            if (!(a._data[index] == b._data[index]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+  private:
+    Type *_data = nullptr;
+    int _size = 0;
+};
+} // namespace bn
+
+#endif
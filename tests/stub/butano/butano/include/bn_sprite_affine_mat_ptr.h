@@ -0,0 +1,50 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_SPRITE_AFFINE_MAT_PTR_H
+#define BN_SPRITE_AFFINE_MAT_PTR_H
+
+#include "bn_fixed.h"
+
+namespace bn
+{
+// Reference counted handle to an emulated sprite affine matrix:
+class sprite_affine_mat_ptr
+{
+  public:
+    [[nodiscard]] static sprite_affine_mat_ptr create();
+
+    sprite_affine_mat_ptr(const sprite_affine_mat_ptr &other);
+
+    sprite_affine_mat_ptr &operator=(const sprite_affine_mat_ptr &other);
+
+    sprite_affine_mat_ptr(sprite_affine_mat_ptr &&other) noexcept;
+
+    sprite_affine_mat_ptr &operator=(sprite_affine_mat_ptr &&other) noexcept;
+
+    ~sprite_affine_mat_ptr();
+
+    [[nodiscard]] int id() const
+    {
+        return _id;
+    }
+
+    [[nodiscard]] fixed scale() const;
+
+    void set_scale(fixed scale);
+
+    [[nodiscard]] fixed rotation_angle() const;
+
+    void set_rotation_angle(fixed rotation_angle);
+
+  private:
+    int _id;
+
+    explicit sprite_affine_mat_ptr(int id) : _id(id)
+    {
+    }
+};
+} // namespace bn
+
+#endif
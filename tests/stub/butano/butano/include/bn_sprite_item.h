@@ -0,0 +1,47 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_SPRITE_ITEM_H
+#define BN_SPRITE_ITEM_H
+
+#include "bn_sprite_palette_item.h"
+#include "bn_sprite_shape_size.h"
+#include "bn_sprite_tiles_item.h"
+
+namespace bn
+{
+class sprite_item
+{
+  public:
+    constexpr sprite_item(const sprite_shape_size &shape_size,
+                          const sprite_tiles_item &tiles_item,
+                          const sprite_palette_item &palette_item)
+        : _shape_size(shape_size), _tiles_item(tiles_item),
+          _palette_item(palette_item)
+    {
+    }
+
+    [[nodiscard]] constexpr const sprite_shape_size &shape_size() const
+    {
+        return _shape_size;
+    }
+
+    [[nodiscard]] constexpr const sprite_tiles_item &tiles_item() const
+    {
+        return _tiles_item;
+    }
+
+    [[nodiscard]] constexpr const sprite_palette_item &palette_item() const
+    {
+        return _palette_item;
+    }
+
+  private:
+    sprite_shape_size _shape_size;
+    sprite_tiles_item _tiles_item;
+    sprite_palette_item _palette_item;
+};
+} // namespace bn
+
+#endif
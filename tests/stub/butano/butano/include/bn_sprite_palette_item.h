@@ -0,0 +1,44 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_SPRITE_PALETTE_ITEM_H
+#define BN_SPRITE_PALETTE_ITEM_H
+
+#include "bn_bpp_mode.h"
+#include "bn_sprite_palette_ptr.h"
+
+namespace bn
+{
+class sprite_palette_item
+{
+  public:
+    constexpr sprite_palette_item(const span<const color> &colors_ref,
+                                  bpp_mode bpp)
+        : _colors_ref(colors_ref), _bpp(bpp)
+    {
+        BN_ASSERT(colors_ref.size() >= 1 && colors_ref.size() <= 16,
+                  "Invalid colors count: ", colors_ref.size());
+    }
+
+    [[nodiscard]] constexpr const span<const color> &colors_ref() const
+    {
+        return _colors_ref;
+    }
+
+    [[nodiscard]] constexpr bpp_mode bpp() const
+    {
+        return _bpp;
+    }
+
+    [[nodiscard]] sprite_palette_ptr create_palette() const;
+
+    [[nodiscard]] sprite_palette_ptr create_new_palette() const;
+
+  private:
+    span<const color> _colors_ref;
+    bpp_mode _bpp;
+};
+} // namespace bn
+
+#endif
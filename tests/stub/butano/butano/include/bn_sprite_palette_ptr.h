@@ -0,0 +1,56 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_SPRITE_PALETTE_PTR_H
+#define BN_SPRITE_PALETTE_PTR_H
+
+#include "bn_color.h"
+#include "bn_fixed.h"
+#include "bn_span.h"
+
+namespace bn
+{
+class sprite_palette_item;
+
+// Reference counted handle to a palette of the emulated palette RAM:
+class sprite_palette_ptr
+{
+  public:
+    sprite_palette_ptr(const sprite_palette_ptr &other);
+
+    sprite_palette_ptr &operator=(const sprite_palette_ptr &other);
+
+    sprite_palette_ptr(sprite_palette_ptr &&other) noexcept;
+
+    sprite_palette_ptr &operator=(sprite_palette_ptr &&other) noexcept;
+
+    ~sprite_palette_ptr();
+
+    [[nodiscard]] int id() const
+    {
+        return _id;
+    }
+
+    [[nodiscard]] span<const color> colors() const;
+
+    void set_colors(const sprite_palette_item &palette_item);
+
+    [[nodiscard]] color fade_color() const;
+
+    [[nodiscard]] fixed fade_intensity() const;
+
+    void set_fade(color color, fixed intensity);
+
+  private:
+    friend class sprite_palette_item;
+
+    int _id;
+
+    explicit sprite_palette_ptr(int id) : _id(id)
+    {
+    }
+};
+} // namespace bn
+
+#endif
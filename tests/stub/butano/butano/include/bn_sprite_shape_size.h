@@ -0,0 +1,68 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_SPRITE_SHAPE_SIZE_H
+#define BN_SPRITE_SHAPE_SIZE_H
+
+#include "bn_common.h"
+
+namespace bn
+{
+enum class sprite_shape : uint8_t
+{
+    SQUARE,
+    WIDE,
+    TALL
+};
+
+enum class sprite_size : uint8_t
+{
+    SMALL,
+    NORMAL,
+    BIG,
+    HUGE
+};
+
+class sprite_shape_size
+{
+  public:
+    constexpr sprite_shape_size(sprite_shape shape, sprite_size size)
+        : _shape(shape), _size(size)
+    {
+    }
+
+    [[nodiscard]] constexpr sprite_shape shape() const
+    {
+        return _shape;
+    }
+
+    [[nodiscard]] constexpr sprite_size size() const
+    {
+        return _size;
+    }
+
+    [[nodiscard]] constexpr int width() const
+    {
+        constexpr int widths[3][4] = {
+            {8, 16, 32, 64}, {16, 32, 32, 64}, {8, 8, 16, 32}};
+        return widths[int(_shape)][int(_size)];
+    }
+
+    [[nodiscard]] constexpr int height() const
+    {
+        constexpr int heights[3][4] = {
+            {8, 16, 32, 64}, {8, 8, 16, 32}, {16, 32, 32, 64}};
+        return heights[int(_shape)][int(_size)];
+    }
+
+    [[nodiscard]] constexpr friend bool operator==(
+        const sprite_shape_size &a, const sprite_shape_size &b) = default;
+
+  private:
+    sprite_shape _shape;
+    sprite_size _size;
+};
+} // namespace bn
+
+#endif
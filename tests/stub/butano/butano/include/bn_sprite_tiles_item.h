@@ -0,0 +1,68 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ *
+ * Instead of tiles data, items have a function which returns the palette
+ * index of each pixel (0 is transparent).
+ */
+
+#ifndef BN_SPRITE_TILES_ITEM_H
+#define BN_SPRITE_TILES_ITEM_H
+
+#include "bn_bpp_mode.h"
+#include "bn_sprite_tiles_ptr.h"
+
+namespace bn
+{
+class sprite_tiles_item
+{
+  public:
+    using pixel_function = int (*)(int graphics_index, int x, int y);
+
+    constexpr sprite_tiles_item(int width, int height, int graphics_count,
+                                pixel_function pixel)
+        : _width(width), _height(height), _graphics_count(graphics_count),
+          _pixel(pixel)
+    {
+    }
+
+    [[nodiscard]] constexpr bpp_mode bpp() const
+    {
+        return bpp_mode::BPP_4;
+    }
+
+    [[nodiscard]] constexpr int width() const
+    {
+        return _width;
+    }
+
+    [[nodiscard]] constexpr int height() const
+    {
+        return _height;
+    }
+
+    [[nodiscard]] constexpr int graphics_count() const
+    {
+        return _graphics_count;
+    }
+
+    [[nodiscard]] constexpr int tiles_count_per_graphic() const
+    {
+        return (_width / 8) * (_height / 8);
+    }
+
+    [[nodiscard]] int pixel(int graphics_index, int x, int y) const
+    {
+        return _pixel(graphics_index, x, y);
+    }
+
+    [[nodiscard]] sprite_tiles_ptr create_tiles(int graphics_index = 0) const;
+
+  private:
+    int _width;
+    int _height;
+    int _graphics_count;
+    pixel_function _pixel;
+};
+} // namespace bn
+
+#endif
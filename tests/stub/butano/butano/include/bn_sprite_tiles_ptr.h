@@ -0,0 +1,46 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_SPRITE_TILES_PTR_H
+#define BN_SPRITE_TILES_PTR_H
+
+#include "bn_common.h"
+
+namespace bn
+{
+class sprite_tiles_item;
+
+// Reference counted handle to tiles allocated in the emulated sprite VRAM:
+class sprite_tiles_ptr
+{
+  public:
+    sprite_tiles_ptr(const sprite_tiles_ptr &other);
+
+    sprite_tiles_ptr &operator=(const sprite_tiles_ptr &other);
+
+    sprite_tiles_ptr(sprite_tiles_ptr &&other) noexcept;
+
+    sprite_tiles_ptr &operator=(sprite_tiles_ptr &&other) noexcept;
+
+    ~sprite_tiles_ptr();
+
+    [[nodiscard]] int id() const
+    {
+        return _id;
+    }
+
+    [[nodiscard]] int tiles_count() const;
+
+  private:
+    friend class sprite_tiles_item;
+
+    int _id;
+
+    explicit sprite_tiles_ptr(int id) : _id(id)
+    {
+    }
+};
+} // namespace bn
+
+#endif
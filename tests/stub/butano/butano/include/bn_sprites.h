@@ -0,0 +1,17 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_SPRITES_H
+#define BN_SPRITES_H
+
+#include "bn_common.h"
+
+namespace bn::sprites
+{
+// There are no sprites handled by Butano on the host, so all emulated OAM
+// entries are hidden:
+void reload();
+} // namespace bn::sprites
+
+#endif
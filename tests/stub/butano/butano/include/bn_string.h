@@ -0,0 +1,121 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_STRING_H
+#define BN_STRING_H
+
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include "bn_common.h"
+
+namespace bn
+{
+template <int MaxSize> class string
+{
+  public:
+    string() = default;
+
+    string(const char *text) : _text(text)
+    {
+    }
+
+    string(const std::string &text) : _text(text)
+    {
+    }
+
+    template <int OtherMaxSize>
+    string(const string<OtherMaxSize> &other) : _text(other.c_str())
+    {
+    }
+
+    [[nodiscard]] const char *c_str() const
+    {
+        return _text.c_str();
+    }
+
+    [[nodiscard]] const char *data() const
+    {
+        return _text.data();
+    }
+
+    [[nodiscard]] int size() const
+    {
+        return int(_text.size());
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return _text.empty();
+    }
+
+    [[nodiscard]] static constexpr int max_size()
+    {
+        return MaxSize;
+    }
+
+    string &append(const char *text)
+    {
+        _text.append(text);
+        return *this;
+    }
+
+    template <int OtherMaxSize> string &append(const string<OtherMaxSize> &text)
+    {
+        _text.append(text.c_str());
+        return *this;
+    }
+
+    string &append(char character)
+    {
+        _text.push_back(character);
+        return *this;
+    }
+
+    template <typename Other> string &operator+=(const Other &other)
+    {
+        return append(other);
+    }
+
+    void clear()
+    {
+        _text.clear();
+    }
+
+    template <typename Other>
+    [[nodiscard]] friend string operator+(string a, const Other &b)
+    {
+        return a.append(b);
+    }
+
+    [[nodiscard]] friend string operator+(const char *a, const string &b)
+    {
+        return string(a).append(b);
+    }
+
+    [[nodiscard]] friend bool operator==(const string &a, const string &b)
+    {
+        return a._text == b._text;
+    }
+
+    friend std::ostream &operator<<(std::ostream &stream, const string &value)
+    {
+        return stream << value._text;
+    }
+
+  private:
+    std::string _text;
+};
+
+template <int MaxSize, typename Type>
+[[nodiscard]] string<MaxSize> to_string(const Type &value)
+{
+    std::ostringstream stream;
+    stream << value;
+    return string<MaxSize>(stream.str());
+}
+} // namespace bn
+
+#endif
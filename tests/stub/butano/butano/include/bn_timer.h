@@ -0,0 +1,48 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ *
+ * Ticks are measured with the host clock, at the rate of the GBA timers.
+ */
+
+#ifndef BN_TIMER_H
+#define BN_TIMER_H
+
+#include <chrono>
+
+#include "bn_timers.h"
+
+namespace bn
+{
+class timer
+{
+  public:
+    timer() : _start(std::chrono::steady_clock::now())
+    {
+    }
+
+    [[nodiscard]] int elapsed_ticks() const
+    {
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - _start)
+                               .count();
+        return int((nanoseconds * timers::ticks_per_second()) / 1000000000);
+    }
+
+    void restart()
+    {
+        _start = std::chrono::steady_clock::now();
+    }
+
+    int elapsed_ticks_with_restart()
+    {
+        int result = elapsed_ticks();
+        restart();
+        return result;
+    }
+
+  private:
+    std::chrono::steady_clock::time_point _start;
+};
+} // namespace bn
+
+#endif
@@ -0,0 +1,23 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_TIMERS_H
+#define BN_TIMERS_H
+
+#include "bn_common.h"
+
+namespace bn::timers
+{
+[[nodiscard]] constexpr int ticks_per_second()
+{
+    return 262144;
+}
+
+[[nodiscard]] constexpr int ticks_per_frame()
+{
+    return 4389;
+}
+} // namespace bn::timers
+
+#endif
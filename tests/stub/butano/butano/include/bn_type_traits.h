@@ -0,0 +1,24 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_TYPE_TRAITS_H
+#define BN_TYPE_TRAITS_H
+
+#include <type_traits>
+
+namespace bn
+{
+using std::conditional_t;
+using std::decay_t;
+using std::enable_if_t;
+using std::is_constant_evaluated;
+using std::is_integral_v;
+using std::is_same_v;
+using std::is_trivially_copyable_v;
+using std::is_trivially_destructible_v;
+using std::remove_const_t;
+using std::remove_reference_t;
+} // namespace bn
+
+#endif
@@ -0,0 +1,41 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_UNORDERED_MAP_H
+#define BN_UNORDERED_MAP_H
+
+#include <unordered_map>
+
+#include "bn_common.h"
+
+namespace bn
+{
+template <typename Key, typename Value, int MaxSize>
+class unordered_map : public std::unordered_map<Key, Value>
+{
+  public:
+    [[nodiscard]] static constexpr int max_size()
+    {
+        return MaxSize;
+    }
+
+    [[nodiscard]] int size() const
+    {
+        return int(std::unordered_map<Key, Value>::size());
+    }
+
+    [[nodiscard]] bool full() const
+    {
+        return size() == MaxSize;
+    }
+
+    Value &operator[](const Key &key)
+    {
+        BN_ASSERT(this->count(key) || !full(), "Map is full");
+        return std::unordered_map<Key, Value>::operator[](key);
+    }
+};
+} // namespace bn
+
+#endif
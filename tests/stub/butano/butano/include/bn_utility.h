@@ -0,0 +1,25 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_UTILITY_H
+#define BN_UTILITY_H
+
+#include <utility>
+
+namespace bn
+{
+using std::forward;
+using std::move;
+using std::pair;
+using std::swap;
+
+// size_t is unsigned int in the GBA:
+template <unsigned... Indexes>
+using index_sequence = std::integer_sequence<unsigned, Indexes...>;
+
+template <unsigned Size>
+using make_index_sequence = std::make_integer_sequence<unsigned, Size>;
+} // namespace bn
+
+#endif
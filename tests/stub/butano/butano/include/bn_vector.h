@@ -0,0 +1,229 @@
+/*
+ * Host stub of the Butano header with the same name, see tests/CMakeLists.txt.
+ */
+
+#ifndef BN_VECTOR_H
+#define BN_VECTOR_H
+
+#include <new>
+
+#include "bn_utility.h"
+
+namespace bn
+{
+template <typename Type, int MaxSize> class vector
+{
+    static_assert(MaxSize > 0, "Invalid max size");
+
+  public:
+    using value_type = Type;
+    using size_type = int;
+    using iterator = Type *;
+    using const_iterator = const Type *;
+
+    vector() = default;
+
+    vector(const vector &other)
+    {
+        for (const Type &value : other)
+        {
+            push_back(value);
+        }
+    }
+
+    vector &operator=(const vector &other)
+    {
+        if (this != &other)
+        {
+            clear();
+
+            for (const Type &value : other)
+            {
+                push_back(value);
+            }
+        }
+
+        return *this;
+    }
+
+    ~vector()
+    {
+        clear();
+    }
+
+    [[nodiscard]] const Type *data() const
+    {
+        return reinterpret_cast<const Type *>(_storage);
+    }
+
+    [[nodiscard]] Type *data()
+    {
+        return reinterpret_cast<Type *>(_storage);
+    }
+
+    [[nodiscard]] int size() const
+    {
+        return _size;
+    }
+
+    [[nodiscard]] static constexpr int max_size()
+    {
+        return MaxSize;
+    }
+
+    [[nodiscard]] int available() const
+    {
+        return MaxSize - _size;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return !_size;
+    }
+
+    [[nodiscard]] bool full() const
+    {
+        return _size == MaxSize;
+    }
+
+    [[nodiscard]] const Type *begin() const
+    {
+        return data();
+    }
+
+    [[nodiscard]] Type *begin()
+    {
+        return data();
+    }
+
+    [[nodiscard]] const Type *end() const
+    {
+        return data() + _size;
+    }
+
+    [[nodiscard]] Type *end()
+    {
+        return data() + _size;
+    }
+
+    [[nodiscard]] const Type &operator[](int index) const
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index);
+        return data()[index];
+    }
+
+    [[nodiscard]] Type &operator[](int index)
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index);
+        return data()[index];
+    }
+
+    [[nodiscard]] const Type &front() const
+    {
+        return (*this)[0];
+    }
+
+    [[nodiscard]] Type &front()
+    {
+        return (*this)[0];
+    }
+
+    [[nodiscard]] const Type &back() const
+    {
+        return (*this)[_size - 1];
+    }
+
+    [[nodiscard]] Type &back()
+    {
+        return (*this)[_size - 1];
+    }
+
+    void push_back(const Type &value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(Type &&value)
+    {
+        emplace_back(move(value));
+    }
+
+    template <typename... Args> Type &emplace_back(Args &&...args)
+    {
+        BN_ASSERT(!full(), "Vector is full");
+
+        Type *result = ::new (data() + _size) Type(forward<Args>(args)...);
+        ++_size;
+        return *result;
+    }
+
+    void pop_back()
+    {
+        BN_ASSERT(_size, "Vector is empty");
+
+        --_size;
+        data()[_size].~Type();
+    }
+
+    Type *erase(Type *position)
+    {
+        BN_ASSERT(position >= begin() && position < end(), "Invalid position");
+
+        for (Type *it = position; it + 1 < end(); ++it)
+        {
+            *it = move(*(it + 1));
+        }
+
+        pop_back();
+        return position;
+    }
+
+    Type *insert(Type *position, const Type &value)
+    {
+        BN_ASSERT(position >= begin() && position <= end(), "Invalid position");
+
+        int index = int(position - begin());
+        push_back(value);
+
+        for (int it = _size - 1; it > index; --it)
+        {
+            swap(data()[it], data()[it - 1]);
+        }
+
+        return begin() + index;
+    }
+
+    void shrink(int count)
+    {
+        BN_ASSERT(count >= 0 && count <= _size, "Invalid count: ", count);
+
+        while (_size > count)
+        {
+            pop_back();
+        }
+    }
+
+    void resize(int count)
+    {
+        BN_ASSERT(count >= 0 && count <= MaxSize, "Invalid count: ", count);
+
+        shrink(count < _size ? count : _size);
+
+        while (_size < count)
+        {
+            emplace_back();
+        }
+    }
+
+    void clear()
+    {
+        shrink(0);
+    }
+
+  private:
+    alignas(Type) unsigned char _storage[sizeof(Type) * MaxSize];
+    int _size = 0;
+};
+} // namespace bn
+
+#endif
@@ -0,0 +1,508 @@
+/*
+ * Host implementation of the Butano stub, see tests/CMakeLists.txt.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+
+#include "bn_assert.h"
+#include "bn_hdma.h"
+#include "bn_host.h"
+#include "bn_profiler.h"
+#include "bn_sprite_affine_mat_ptr.h"
+#include "bn_sprite_palette_item.h"
+#include "bn_sprite_tiles_item.h"
+#include "bn_sprites.h"
+
+#include "../hw/include/bn_hw_sprites.h"
+
+namespace
+{
+constexpr int max_tiles = 1024;
+constexpr int max_palettes = 16;
+constexpr int max_affine_mats = 32;
+
+struct tiles_allocation
+{
+    bn::host::tiles_entry entry;
+    int tiles_count = 0;
+    int references = 0;
+};
+
+struct palette_allocation
+{
+    bn::host::palette_entry entry;
+    int references = 0;
+};
+
+struct affine_mat_allocation
+{
+    bn::host::affine_mat_entry entry;
+    int references = 0;
+};
+
+struct profiler_state
+{
+    std::map<std::string, bn::host::profiler_entry> entries;
+    std::string current_id;
+    std::chrono::steady_clock::time_point current_start;
+};
+
+bn::assert::handler_type assert_handler = nullptr;
+
+// Butano hides all sprites when it's initialized:
+struct oam_state
+{
+    bn::hw::sprites::handle handles[128];
+
+    oam_state()
+    {
+        for (bn::hw::sprites::handle &handle : handles)
+        {
+            bn::hw::sprites::hide_and_destroy(handle.attr0);
+        }
+    }
+} oam;
+bn::host::hdma_transfer running_hdma_transfer;
+bool hdma_running = false;
+tiles_allocation tiles_allocations[max_tiles];
+palette_allocation palette_allocations[max_palettes];
+affine_mat_allocation affine_mat_allocations[max_affine_mats];
+
+profiler_state &profiler_state_ref()
+{
+    static profiler_state result;
+    return result;
+}
+
+void release_tiles(int id)
+{
+    if (id >= 0 && --tiles_allocations[id].references == 0)
+    {
+        int tiles_count = tiles_allocations[id].tiles_count;
+
+        for (int index = 0; index < tiles_count; ++index)
+        {
+            tiles_allocations[id + index].tiles_count = 0;
+        }
+    }
+}
+
+void release_palette(int id)
+{
+    if (id >= 0)
+    {
+        --palette_allocations[id].references;
+    }
+}
+
+void release_affine_mat(int id)
+{
+    if (id >= 0)
+    {
+        --affine_mat_allocations[id].references;
+    }
+}
+
+int create_palette(const bn::sprite_palette_item &palette_item)
+{
+    for (int id = 0; id < max_palettes; ++id)
+    {
+        palette_allocation &allocation = palette_allocations[id];
+
+        if (!allocation.references)
+        {
+            allocation = palette_allocation();
+            allocation.references = 1;
+
+            const bn::span<const bn::color> &colors = palette_item.colors_ref();
+
+            for (int index = 0; index < colors.size(); ++index)
+            {
+                allocation.entry.colors[index] = colors[index];
+            }
+
+            return id;
+        }
+    }
+
+    BN_ERROR("There's no space for more palettes");
+}
+} // namespace
+
+namespace bn::assert
+{
+handler_type set_handler(handler_type handler)
+{
+    handler_type result = assert_handler;
+    assert_handler = handler;
+    return result;
+}
+
+void fail(const std::string &message)
+{
+    if (assert_handler)
+    {
+        assert_handler(message);
+    }
+
+    std::fprintf(stderr, "ASSERT FAILED: %s\n", message.c_str());
+    std::abort();
+}
+} // namespace bn::assert
+
+namespace bn::hw::sprites
+{
+handle *vram()
+{
+    return oam.handles;
+}
+} // namespace bn::hw::sprites
+
+namespace bn::sprites
+{
+void reload()
+{
+    for (hw::sprites::handle &handle : oam.handles)
+    {
+        hw::sprites::hide_and_destroy(handle.attr0);
+    }
+}
+} // namespace bn::sprites
+
+namespace bn::hdma
+{
+bool running()
+{
+    return hdma_running;
+}
+
+void start(const uint16_t &source_ref, int elements, uint16_t &destination_ref)
+{
+    BN_ASSERT(elements > 0, "Invalid elements: ", elements);
+
+    running_hdma_transfer = {&source_ref, elements, &destination_ref};
+    hdma_running = true;
+}
+
+void stop()
+{
+    hdma_running = false;
+}
+} // namespace bn::hdma
+
+namespace bn::profiler
+{
+void start(const char *id)
+{
+    profiler_state &state = profiler_state_ref();
+    BN_ASSERT(state.current_id.empty(), "Profiler already started: ", id);
+
+    state.current_id = id;
+    state.current_start = std::chrono::steady_clock::now();
+}
+
+void stop()
+{
+    profiler_state &state = profiler_state_ref();
+    BN_ASSERT(!state.current_id.empty(), "Profiler not started");
+
+    host::profiler_entry &entry = state.entries[state.current_id];
+    entry.id = state.current_id;
+    entry.total_nanoseconds +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - state.current_start)
+            .count();
+    ++entry.calls;
+    state.current_id.clear();
+}
+
+void reset()
+{
+    profiler_state_ref().entries.clear();
+}
+} // namespace bn::profiler
+
+namespace bn
+{
+sprite_tiles_ptr sprite_tiles_item::create_tiles(int graphics_index) const
+{
+    BN_ASSERT(graphics_index >= 0 && graphics_index < _graphics_count,
+              "Invalid graphics index: ", graphics_index);
+
+    int tiles_count = tiles_count_per_graphic();
+    int id = 0;
+
+    while (id + tiles_count <= max_tiles)
+    {
+        int used_id = -1;
+
+        for (int index = 0; index < tiles_count; ++index)
+        {
+            if (tiles_allocations[id + index].tiles_count)
+            {
+                used_id = id + index;
+                break;
+            }
+        }
+
+        if (used_id < 0)
+        {
+            for (int index = 0; index < tiles_count; ++index)
+            {
+                tiles_allocations[id + index].tiles_count = tiles_count;
+            }
+
+            tiles_allocation &allocation = tiles_allocations[id];
+            allocation.entry = {this, graphics_index};
+            allocation.references = 1;
+            return sprite_tiles_ptr(id);
+        }
+
+        id = used_id + tiles_allocations[used_id].tiles_count;
+    }
+
+    BN_ERROR("There's no space for more tiles");
+}
+
+sprite_tiles_ptr::sprite_tiles_ptr(const sprite_tiles_ptr &other)
+    : _id(other._id)
+{
+    ++tiles_allocations[_id].references;
+}
+
+sprite_tiles_ptr &sprite_tiles_ptr::operator=(const sprite_tiles_ptr &other)
+{
+    ++tiles_allocations[other._id].references;
+    release_tiles(_id);
+    _id = other._id;
+    return *this;
+}
+
+sprite_tiles_ptr::sprite_tiles_ptr(sprite_tiles_ptr &&other) noexcept
+    : _id(other._id)
+{
+    other._id = -1;
+}
+
+sprite_tiles_ptr &sprite_tiles_ptr::operator=(sprite_tiles_ptr &&other) noexcept
+{
+    std::swap(_id, other._id);
+    return *this;
+}
+
+sprite_tiles_ptr::~sprite_tiles_ptr()
+{
+    release_tiles(_id);
+}
+
+int sprite_tiles_ptr::tiles_count() const
+{
+    return tiles_allocations[_id].tiles_count;
+}
+
+sprite_palette_ptr sprite_palette_item::create_palette() const
+{
+    return sprite_palette_ptr(::create_palette(*this));
+}
+
+sprite_palette_ptr sprite_palette_item::create_new_palette() const
+{
+    return sprite_palette_ptr(::create_palette(*this));
+}
+
+sprite_palette_ptr::sprite_palette_ptr(const sprite_palette_ptr &other)
+    : _id(other._id)
+{
+    ++palette_allocations[_id].references;
+}
+
+sprite_palette_ptr &sprite_palette_ptr::operator=(
+    const sprite_palette_ptr &other)
+{
+    ++palette_allocations[other._id].references;
+    release_palette(_id);
+    _id = other._id;
+    return *this;
+}
+
+sprite_palette_ptr::sprite_palette_ptr(sprite_palette_ptr &&other) noexcept
+    : _id(other._id)
+{
+    other._id = -1;
+}
+
+sprite_palette_ptr &sprite_palette_ptr::operator=(
+    sprite_palette_ptr &&other) noexcept
+{
+    std::swap(_id, other._id);
+    return *this;
+}
+
+sprite_palette_ptr::~sprite_palette_ptr()
+{
+    release_palette(_id);
+}
+
+span<const color> sprite_palette_ptr::colors() const
+{
+    return span<const color>(palette_allocations[_id].entry.colors, 16);
+}
+
+void sprite_palette_ptr::set_colors(const sprite_palette_item &palette_item)
+{
+    const span<const color> &colors = palette_item.colors_ref();
+    host::palette_entry &entry = palette_allocations[_id].entry;
+
+    for (int index = 0; index < colors.size(); ++index)
+    {
+        entry.colors[index] = colors[index];
+    }
+}
+
+color sprite_palette_ptr::fade_color() const
+{
+    return palette_allocations[_id].entry.fade_color;
+}
+
+fixed sprite_palette_ptr::fade_intensity() const
+{
+    return palette_allocations[_id].entry.fade_intensity;
+}
+
+void sprite_palette_ptr::set_fade(color color, fixed intensity)
+{
+    BN_ASSERT(intensity >= 0 && intensity <= 1, "Invalid intensity: ",
+              intensity);
+
+    host::palette_entry &entry = palette_allocations[_id].entry;
+    entry.fade_color = color;
+    entry.fade_intensity = intensity;
+}
+
+sprite_affine_mat_ptr sprite_affine_mat_ptr::create()
+{
+    for (int id = 0; id < max_affine_mats; ++id)
+    {
+        affine_mat_allocation &allocation = affine_mat_allocations[id];
+
+        if (!allocation.references)
+        {
+            allocation = affine_mat_allocation();
+            allocation.references = 1;
+            return sprite_affine_mat_ptr(id);
+        }
+    }
+
+    BN_ERROR("There's no space for more affine matrices");
+}
+
+sprite_affine_mat_ptr::sprite_affine_mat_ptr(const sprite_affine_mat_ptr &other)
+    : _id(other._id)
+{
+    ++affine_mat_allocations[_id].references;
+}
+
+sprite_affine_mat_ptr &sprite_affine_mat_ptr::operator=(
+    const sprite_affine_mat_ptr &other)
+{
+    ++affine_mat_allocations[other._id].references;
+    release_affine_mat(_id);
+    _id = other._id;
+    return *this;
+}
+
+sprite_affine_mat_ptr::sprite_affine_mat_ptr(
+    sprite_affine_mat_ptr &&other) noexcept
+    : _id(other._id)
+{
+    other._id = -1;
+}
+
+sprite_affine_mat_ptr &sprite_affine_mat_ptr::operator=(
+    sprite_affine_mat_ptr &&other) noexcept
+{
+    std::swap(_id, other._id);
+    return *this;
+}
+
+sprite_affine_mat_ptr::~sprite_affine_mat_ptr()
+{
+    release_affine_mat(_id);
+}
+
+fixed sprite_affine_mat_ptr::scale() const
+{
+    return affine_mat_allocations[_id].entry.scale;
+}
+
+void sprite_affine_mat_ptr::set_scale(fixed scale)
+{
+    affine_mat_allocations[_id].entry.scale = scale;
+}
+
+fixed sprite_affine_mat_ptr::rotation_angle() const
+{
+    return affine_mat_allocations[_id].entry.rotation_angle;
+}
+
+void sprite_affine_mat_ptr::set_rotation_angle(fixed rotation_angle)
+{
+    affine_mat_allocations[_id].entry.rotation_angle = rotation_angle;
+}
+} // namespace bn
+
+namespace bn::host
+{
+const hdma_transfer *hdma()
+{
+    return hdma_running ? &running_hdma_transfer : nullptr;
+}
+
+const tiles_entry *tiles(int tiles_id)
+{
+    if (tiles_id < 0 || tiles_id >= max_tiles ||
+        !tiles_allocations[tiles_id].references)
+    {
+        return nullptr;
+    }
+
+    return &tiles_allocations[tiles_id].entry;
+}
+
+const palette_entry *palette(int palette_id)
+{
+    if (palette_id < 0 || palette_id >= max_palettes ||
+        !palette_allocations[palette_id].references)
+    {
+        return nullptr;
+    }
+
+    return &palette_allocations[palette_id].entry;
+}
+
+const affine_mat_entry *affine_mat(int affine_mat_id)
+{
+    if (affine_mat_id < 0 || affine_mat_id >= max_affine_mats ||
+        !affine_mat_allocations[affine_mat_id].references)
+    {
+        return nullptr;
+    }
+
+    return &affine_mat_allocations[affine_mat_id].entry;
+}
+
+std::vector<profiler_entry> profiler_entries()
+{
+    std::vector<profiler_entry> result;
+
+    for (const auto &[id, entry] : profiler_state_ref().entries)
+    {
+        result.push_back(entry);
+    }
+
+    return result;
+}
+} // namespace bn::host
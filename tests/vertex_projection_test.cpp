@@ -0,0 +1,335 @@
+/*
+ * Bit-exact tests of the ARM kernel in fr_project_vertices.s against
+ * fr::vertex_projection::project, run with the ARM interpreter of
+ * arm_interpreter.h.
+ *
+ * The kernel is assembled by the build and its code is read from
+ * FR_PROJECT_VERTICES_BIN.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "fr_camera_3d.h"
+#include "fr_vertex_projection.h"
+
+#include "arm_interpreter.h"
+#include "host_test.h"
+
+namespace
+{
+namespace projection = fr::vertex_projection;
+
+constexpr int max_vertices = 64;
+constexpr int div_lut_size = 1024 * 4;
+
+// Emulated memory map:
+constexpr uint32_t code_address = 0x03000000;
+constexpr uint32_t params_address = 0x03001000;
+constexpr uint32_t vertices_address = 0x03002000;
+constexpr uint32_t output_address = 0x03003000;
+constexpr uint32_t stack_address = 0x03003800;
+constexpr uint32_t div_lut_address = 0x03004000;
+constexpr int memory_size = 0x8000;
+
+static_assert(div_lut_address + (div_lut_size * 4) <=
+              code_address + memory_size);
+static_assert(max_vertices * int(sizeof(fr::vertex_3d)) <= 0x1000);
+
+// Worst case cycles per projected vertex of the kernel:
+constexpr int max_kernel_cycles_per_vertex = 93;
+
+// Output entries not written by the kernel keep this value:
+constexpr int16_t unused_output = 0x5555;
+
+class kernel_runner
+{
+  public:
+    kernel_runner() : _cpu(code_address, memory_size)
+    {
+        std::ifstream file(FR_PROJECT_VERTICES_BIN, std::ios::binary);
+        std::vector<char> code((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+        _loaded = !code.empty() && code.size() <= 0x1000;
+
+        if (_loaded)
+        {
+            _cpu.write(code_address, code.data(), int(code.size()));
+        }
+
+        _cpu.write(div_lut_address, fr::div_lut_ptr, div_lut_size * 4);
+    }
+
+    [[nodiscard]] bool loaded() const
+    {
+        return _loaded;
+    }
+
+    // Returns -1 if the kernel fails to run:
+    [[nodiscard]] int project(const std::vector<fr::vertex_3d> &vertices,
+                              projection::point *projected_vertices,
+                              const projection::params &params)
+    {
+        // The div LUT pointer is 32 bits wide in the GBA:
+        uint32_t kernel_params[13];
+        std::memcpy(kernel_params, &params, 12 * 4);
+        kernel_params[12] = div_lut_address;
+        _cpu.write(params_address, kernel_params, sizeof(kernel_params));
+
+        int vertices_count = int(vertices.size());
+        _cpu.write(vertices_address, vertices.data(),
+                   vertices_count * int(sizeof(fr::vertex_3d)));
+
+        std::vector<projection::point> output(
+            max_vertices, {unused_output, unused_output});
+        _cpu.write(output_address, output.data(),
+                   max_vertices * int(sizeof(projection::point)));
+
+        uint32_t arguments[4] = {vertices_address, uint32_t(vertices_count),
+                                 output_address, params_address};
+
+        if (!_cpu.call(code_address, arguments, stack_address, 100000))
+        {
+            host_test::add_failure(__FILE__, __LINE__, _cpu.error());
+            return -1;
+        }
+
+        _cpu.read(output_address, projected_vertices,
+                  max_vertices * int(sizeof(projection::point)));
+        return int(_cpu.reg(0));
+    }
+
+    // ARM7TDMI cycles of the last project() call:
+    [[nodiscard]] int cycles() const
+    {
+        return _cpu.cycles();
+    }
+
+  private:
+    arm_interpreter::cpu _cpu;
+    bool _loaded = false;
+};
+
+[[nodiscard]] projection::params camera_params(const fr::camera_3d &camera)
+{
+    const fr::point_3d &position = camera.position();
+    return {position.x().data(), position.y().data(), position.z().data(),
+            camera.u().x().data(), camera.u().y().data(), camera.u().z().data(),
+            camera.v().x().data(), camera.v().y().data(), camera.v().z().data(),
+            camera.w().x().data(), camera.w().y().data(), camera.w().z().data(),
+            fr::div_lut_ptr};
+}
+
+// Runs the kernel and the C++ reference with the given vertices. Returns the
+// number of projected vertices, or -1 if they're different:
+[[nodiscard]] int check_projection(kernel_runner &runner,
+                                   const std::vector<fr::vertex_3d> &vertices,
+                                   const projection::params &params)
+{
+    projection::point expected[max_vertices];
+    projection::point actual[max_vertices];
+    std::fill(std::begin(expected), std::end(expected),
+              projection::point{unused_output, unused_output});
+
+    int expected_count =
+        projection::project(vertices.data(), int(vertices.size()), expected,
+                            params);
+    int actual_count = runner.project(vertices, actual, params);
+    CHECK_EQUAL(actual_count, expected_count);
+
+    if (actual_count != expected_count)
+    {
+        return -1;
+    }
+
+    for (int index = 0; index < max_vertices; ++index)
+    {
+        CHECK_EQUAL(actual[index].x, expected[index].x);
+        CHECK_EQUAL(actual[index].y, expected[index].y);
+
+        if (actual[index].x != expected[index].x ||
+            actual[index].y != expected[index].y)
+        {
+            return -1;
+        }
+    }
+
+    return actual_count;
+}
+
+// Random vertices in front of the camera, inside the range of the div LUT:
+[[nodiscard]] fr::vertex_3d random_vertex(std::mt19937 &random,
+                                          const fr::camera_3d &camera,
+                                          int minimum_depth, int maximum_depth)
+{
+    std::uniform_int_distribution<int> side(-256 * 4096, 256 * 4096);
+    std::uniform_int_distribution<int> depth(minimum_depth * 4096,
+                                             maximum_depth * 4096);
+    bn::fixed x = bn::fixed::from_data(side(random)) / 2;
+    bn::fixed y = bn::fixed::from_data(side(random)) / 2;
+    bn::fixed z = bn::fixed::from_data(depth(random));
+    fr::point_3d point = camera.position() + (camera.u() * x) +
+                         (camera.v() * y) - (camera.w() * z);
+    return fr::vertex_3d(point);
+}
+
+[[nodiscard]] fr::camera_3d random_camera(std::mt19937 &random)
+{
+    std::uniform_int_distribution<int> position(-2048 * 4096, 2048 * 4096);
+    std::uniform_int_distribution<int> angle(0, 65535);
+    fr::camera_3d result;
+    result.set_position(fr::point_3d(bn::fixed::from_data(position(random)),
+                                     bn::fixed::from_data(position(random)),
+                                     bn::fixed::from_data(position(random))));
+    result.set_phi(angle(random));
+    result.set_theta(angle(random));
+    result.set_psi(angle(random));
+    return result;
+}
+} // namespace
+
+HOST_TEST(kernel_matches_reference_with_vertices_in_front)
+{
+    kernel_runner runner;
+    CHECK(runner.loaded());
+
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<int> vertices_count(0, max_vertices);
+
+    for (int batch = 0; batch < 500 && runner.loaded(); ++batch)
+    {
+        fr::camera_3d camera = random_camera(random);
+        std::vector<fr::vertex_3d> vertices;
+        int count = vertices_count(random);
+
+        for (int index = 0; index < count; ++index)
+        {
+            vertices.push_back(random_vertex(random, camera, 25, 600));
+        }
+
+        int projected_count =
+            check_projection(runner, vertices, camera_params(camera));
+
+        if (projected_count != count)
+        {
+            CHECK_EQUAL(projected_count, count);
+            return;
+        }
+    }
+}
+
+HOST_TEST(kernel_stops_at_the_near_plane_like_reference)
+{
+    kernel_runner runner;
+    CHECK(runner.loaded());
+
+    std::mt19937 random(5678);
+    std::uniform_int_distribution<int> vertices_count(1, max_vertices);
+
+    for (int batch = 0; batch < 500 && runner.loaded(); ++batch)
+    {
+        fr::camera_3d camera = random_camera(random);
+        std::vector<fr::vertex_3d> vertices;
+        int count = vertices_count(random);
+
+        for (int index = 0; index < count; ++index)
+        {
+            vertices.push_back(random_vertex(random, camera, 25, 600));
+        }
+
+        // Puts a vertex behind the near plane, behind the camera or right at
+        // the near plane:
+        int near_index =
+            std::uniform_int_distribution<int>(0, count - 1)(random);
+        int near_depth = std::uniform_int_distribution<int>(-100, 23)(random);
+        vertices[near_index] =
+            random_vertex(random, camera, near_depth, near_depth + 1);
+
+        int projected_count =
+            check_projection(runner, vertices, camera_params(camera));
+
+        if (projected_count != near_index)
+        {
+            CHECK_EQUAL(projected_count, near_index);
+            return;
+        }
+    }
+}
+
+HOST_TEST(kernel_matches_reference_with_translation_offsets)
+{
+    kernel_runner runner;
+    CHECK(runner.loaded());
+
+    // Translation only models move the camera offset by the model position:
+    std::mt19937 random(9012);
+    std::uniform_int_distribution<int> offset(-64 * 4096, 64 * 4096);
+
+    for (int batch = 0; batch < 200 && runner.loaded(); ++batch)
+    {
+        fr::camera_3d camera = random_camera(random);
+        projection::params params = camera_params(camera);
+        fr::point_3d model_position(bn::fixed::from_data(offset(random)),
+                                    bn::fixed::from_data(offset(random)),
+                                    bn::fixed::from_data(offset(random)));
+        params.offset_x -= model_position.x().data();
+        params.offset_y -= model_position.y().data();
+        params.offset_z -= model_position.z().data();
+
+        std::vector<fr::vertex_3d> vertices;
+
+        for (int index = 0; index < max_vertices; ++index)
+        {
+            fr::vertex_3d vertex = random_vertex(random, camera, 100, 400);
+            vertices.emplace_back(vertex.point() - model_position);
+        }
+
+        if (check_projection(runner, vertices, params) < 0)
+        {
+            return;
+        }
+    }
+}
+
+HOST_TEST(kernel_cycles_per_vertex_are_in_budget)
+{
+    kernel_runner runner;
+    CHECK(runner.loaded());
+
+    // Multiplies take from 2 to 5 cycles depending on their operands, so
+    // the worst batch is measured:
+    std::mt19937 random(3456);
+    int max_cycles_per_vertex = 0;
+
+    for (int batch = 0; batch < 100 && runner.loaded(); ++batch)
+    {
+        fr::camera_3d camera = random_camera(random);
+        projection::params params = camera_params(camera);
+        projection::point output[max_vertices];
+        std::vector<fr::vertex_3d> vertices;
+
+        (void)runner.project(vertices, output, params);
+        int call_cycles = runner.cycles();
+
+        for (int index = 0; index < max_vertices; ++index)
+        {
+            vertices.push_back(random_vertex(random, camera, 25, 600));
+        }
+
+        CHECK_EQUAL(runner.project(vertices, output, params), max_vertices);
+
+        int cycles_per_vertex =
+            (runner.cycles() - call_cycles + max_vertices - 1) / max_vertices;
+        max_cycles_per_vertex =
+            std::max(max_cycles_per_vertex, cycles_per_vertex);
+    }
+
+    std::printf("fr_project_vertices: %d cycles per vertex\n",
+                max_cycles_per_vertex);
+    CHECK(max_cycles_per_vertex <= max_kernel_cycles_per_vertex);
+}
@@ -9,18 +9,32 @@ Usage (PowerShell):
 
 If output path is omitted it writes the header to:
   include/game_scene_defs/<scene_name>_defs.h
+
+Setting "mergeStaticModels": true in the scene (or in a single section, which
+overrides the scene value) welds the enabled static models of each section into
+a single merged_static_model_3d_item, so the renderer processes them as one model
+with shared vertices. Lower detail levels of the merged models are not used.
+
+For each camera Y band between section boundaries, the header also contains a
+stage_band_budget with the worst-case load of the active sections, checked with
+static_assert against the renderer limits (see STAGE_BAND_BUDGET_CHECK in
+stage_budget.h). Loads are only computed by the compiler, so merged sections
+count their welded vertices; when a band overruns a limit, the build error
+shows its load and the limit.
 """
 
 import json
 import sys
 from pathlib import Path
-from typing import Any, Dict, List, Set
+from typing import Any, Dict, List, Set, Tuple
 from termcolor import colored
 
 # Core always-needed structural includes (edit here if structural dependencies change)
 STRUCTURAL_INCLUDES = [
     'scene_colors_generator.h',
     'stage_section.h',
+    'stage_event.h',
+    'stage_budget.h',
     'static_model_3d_item.h',
     'enemy_def.h',
     'bn_color.h',
@@ -47,7 +61,6 @@ MODEL_HEADER_OVERRIDES: Dict[str, str] = {}
 # Optional explicit symbol overrides (if fr::model_3d_items symbol differs)
 MODEL_SYMBOL_OVERRIDES: Dict[str, str] = {}
 
-
 def _macro_guard(name: str) -> str:
     return ''.join(c.upper() if c.isalnum() else '_' for c in f"{name}_defs_h")
 
@@ -72,12 +85,32 @@ def _symbol_from_model(model_name: str) -> str:
     return MODEL_SYMBOL_OVERRIDES.get(model_name, model_name)
 
 
+def _section_merges_static_models(section: Dict[str, Any], scene_default: bool) -> bool:
+    # Merging a single model only drops its lower detail levels.
+    if not section.get('mergeStaticModels', scene_default):
+        return False
+    enabled_models = [m for m in section.get('staticModels', []) if m.get('enabled', True)]
+    return len(enabled_models) > 1
+
+
+def _stage_bands(sections: List[Dict[str, Any]]) -> List[Tuple[int, int, List[Dict[str, Any]]]]:
+    """Camera Y bands between section boundaries with at least one active section, from the stage start."""
+    bounds = sorted({s['range'][key] for s in sections for key in ('start', 'end')}, reverse=True)
+    bands = []
+    for start, end in zip(bounds, bounds[1:]):
+        active = [s for s in sections if s['range']['start'] >= start and s['range']['end'] <= end]
+        if active:
+            bands.append((start, end, active))
+    return bands
+
+
 def generate_header(scene: Dict[str, Any]) -> str:
     name = scene['name']
     palette: List[str] = scene.get('palette', [])
     sections: List[Dict[str, Any]] = scene.get('sections', [])
 
     guard = _macro_guard(name)
+    merge_static_models = scene.get('mergeStaticModels', False)
 
     # Collect model names actually used (enabled only) for includes.
     model_names: Set[str] = set()
@@ -114,10 +147,15 @@ def generate_header(scene: Dict[str, Any]) -> str:
 
     # 3. Model headers already resolved (model_headers)
 
+    # Merged static models header is only needed if a section uses it
+    structural_includes = list(STRUCTURAL_INCLUDES)
+    if any(_section_merges_static_models(s, merge_static_models) for s in sections):
+        structural_includes.append('merged_static_model_3d_item.h')
+
     # Combine and deduplicate preserving order (structural -> palette -> models)
     ordered_all = []
     seen = set()
-    for group in (STRUCTURAL_INCLUDES, palette_includes, model_headers):
+    for group in (structural_includes, palette_includes, model_headers):
         for inc in group:
             if inc not in seen:
                 ordered_all.append(inc)
@@ -179,6 +217,18 @@ def generate_header(scene: Dict[str, Any]) -> str:
             # remove last comma for neatness (optional)
             model_items_lines[-1] = model_items_lines[-1].rstrip(',')
 
+        # Weld the section static models into a single one
+        merged_model_lines: List[str] = []
+        if _section_merges_static_models(s, merge_static_models):
+            merged_model_lines.append(f"constexpr fr::model_3d_item _section_{sid}_merged_model_items[] = {{")
+            merged_model_lines.extend(model_items_lines)
+            merged_model_lines.append("};")
+            merged_model_lines.append("")
+            merged_model_lines.append(f"constexpr merged_static_model_3d_item<_section_{sid}_merged_model_items>\n"
+                                      f"    _section_{sid}_merged_model;")
+            merged_model_lines.append("")
+            model_items_lines = [f"    _section_{sid}_merged_model.item()"]
+
         # Collect sphere colliders from static models (convert to world-space)
         collider_lines: List[str] = []
         collider_index = 0
@@ -255,6 +305,7 @@ def generate_header(scene: Dict[str, Any]) -> str:
         section_src.extend(enemy_property_const_lines)
         if enemy_property_const_lines:
             section_src.append("")
+        section_src.extend(merged_model_lines)
         # Explicitly type initializer_lists so empty lists compile (no deduction failure)
         if model_items_lines:
             section_src.append(f"constexpr std::initializer_list<fr::model_3d_item> _section_{sid}_static_model_items = {{")
@@ -306,6 +357,35 @@ def generate_header(scene: Dict[str, Any]) -> str:
         "};\n\nconstexpr stage_section_list_ptr sections = sections_full.begin();\nconstexpr size_t sections_count = sections_full.size();"
     )
 
+    # Spawn and despawn events, sorted by decreasing y (the camera moves along -Y) with despawns first on ties.
+    # Only sections with enemies or ending the stage need them.
+    events = []
+    for section_index, s in enumerate(sections):
+        has_enemies = any(e.get('enabled', True) for e in s.get('enemies', []))
+        if has_enemies or s.get('end_section', False):
+            events.append((s['range']['start'], 'SPAWN', section_index))
+        if has_enemies:
+            events.append((s['range']['end'], 'DESPAWN', section_index))
+    events.sort(key=lambda event: (-event[0], event[1] != 'DESPAWN', event[2]))
+    event_lines = [f"    {{{position}, stage_event_type::{event_type}, {section_index}}},"
+                   for position, event_type, section_index in events]
+    if event_lines:
+        event_lines[-1] = event_lines[-1].rstrip(',')
+        events_block = "constexpr stage_event stage_events[] = {\n" + '\n'.join(event_lines) + "\n};"
+    else:
+        events_block = "constexpr bn::span<const stage_event> stage_events;"
+
+    # Worst-case load of each camera Y band, checked against the renderer limits at compile time
+    band_lines = [f"    stage_band_budget(sections, sections_count, {start}, {end}),"
+                  for start, end, _ in _stage_bands(sections)]
+    if band_lines:
+        band_lines[-1] = band_lines[-1].rstrip(',')
+        budget_block = "constexpr stage_band_budget stage_band_budgets[] = {\n" + '\n'.join(band_lines) + "\n};\n"
+        for band_index, (start, end, _) in enumerate(_stage_bands(sections)):
+            budget_block += f"\nSTAGE_BAND_BUDGET_CHECK(stage_band_budgets[{band_index}], \"Band {start}..{end}\");"
+    else:
+        budget_block = "constexpr bn::span<const stage_band_budget> stage_band_budgets;"
+
     # Palette / colors block
     palette_lines = []
     palette_lines.append("constexpr const auto raw_scene_colors = {")
@@ -337,6 +417,10 @@ def generate_header(scene: Dict[str, Any]) -> str:
     header_lines.append('\n\n'.join(section_blocks))
     header_lines.append("\n// # Sections List\n")
     header_lines.append(sections_full_block)
+    header_lines.append("\n// # Events\n")
+    header_lines.append(events_block)
+    header_lines.append("\n// # Budget\n")
+    header_lines.append(budget_block)
     header_lines.append("\n// --- Colors\n")
     header_lines.extend(palette_lines)
     header_lines.append("\n#endif")
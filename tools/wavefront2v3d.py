@@ -41,15 +41,119 @@ def normal(p0, p1, p2):
     return [cross_product[0] / magnitude, cross_product[1] / magnitude, cross_product[2] / magnitude]
 
 
+def parse_lod(value: str):
+    """Parses a 'distance:cell_size' LOD argument."""
+    distance, cell_size = value.split(':', 1)
+    return {'distance': int(distance), 'cell_size': float(cell_size)}
+
+
+def decimate(vertices, faces, materials, brightness, cell_size):
+    """Simplifies a mesh by vertex clustering.
+
+    Vertices inside the same cell_size sized grid cell are merged into their average.
+    Faces which end up with less than 3 different vertices are removed, quads which
+    lose a vertex become triangles and normals are recalculated.
+    Returns (vertices, faces, normals, materials, brightness) of the simplified mesh.
+    """
+    cluster_indices = {}
+    cluster_sums = []
+    vertex_clusters = []
+
+    for v in vertices:
+        key = tuple(math.floor(c / cell_size) for c in v)
+        cluster = cluster_indices.get(key)
+        if cluster is None:
+            cluster = len(cluster_sums)
+            cluster_indices[key] = cluster
+            cluster_sums.append([0.0, 0.0, 0.0, 0])
+        cluster_sum = cluster_sums[cluster]
+        cluster_sum[0] += v[0]
+        cluster_sum[1] += v[1]
+        cluster_sum[2] += v[2]
+        cluster_sum[3] += 1
+        vertex_clusters.append(cluster)
+
+    cluster_points = [[s[0] / s[3], s[1] / s[3], s[2] / s[3]] for s in cluster_sums]
+
+    out_faces = []
+    out_normals = []
+    out_materials = []
+    out_brightness = []
+    used_faces = set()
+
+    for fi, face in enumerate(faces):
+        indices = []
+        for vi in face:
+            cluster = vertex_clusters[int(vi)]
+            if cluster not in indices:
+                indices.append(cluster)
+        if len(indices) < 3 or len(indices) > 4:
+            continue
+        points = [tuple(cluster_points[i]) for i in indices]
+        if len(set(points)) != len(points):
+            continue
+        face_key = tuple(sorted(indices))
+        if face_key in used_faces:
+            continue
+        cross_product = cross(sub(points[1], points[0]), sub(points[2], points[0]))
+        if norm(cross_product) < 1e-6:
+            continue
+        used_faces.add(face_key)
+        out_faces.append(indices)
+        out_normals.append(normal(points[0], points[1], points[2]))
+        out_materials.append(materials[fi])
+        out_brightness.append(brightness[fi])
+
+    # Remove unused vertices:
+    remap = {}
+    out_vertices = []
+    for face in out_faces:
+        for i in face:
+            if i not in remap:
+                remap[i] = len(out_vertices)
+                out_vertices.append(cluster_points[i])
+    out_faces = [[str(remap[i]) for i in face] for face in out_faces]
+    return out_vertices, out_faces, out_normals, out_materials, out_brightness
+
+
+def cluster_faces(normals):
+    """Groups faces by the dominant axis of their normals (+x, -x, +y, ...), so the
+    normals of each group fit in a cone narrower than 90 degrees.
+    Returns the new faces order and the faces count of each group."""
+    groups = {}
+    for index, n in enumerate(normals):
+        n = [float(c) for c in n]
+        axis = max(range(3), key=lambda a: abs(n[a]))
+        groups.setdefault(axis * 2 + (0 if n[axis] >= 0 else 1), []).append(index)
+    order = []
+    counts = []
+    for key in sorted(groups):
+        order += groups[key]
+        counts.append(len(groups[key]))
+    return order, counts
+
+
 def convert_wavefront(obj_path: str, out_path: str, modelname: str, modelscale: float, 
-                       recalcvertexnorms: bool = False, metadata_path: Optional[str] = None):
+                       recalcvertexnorms: bool = False, metadata_path: Optional[str] = None,
+                       lods: Optional[List[dict]] = None, packed_faces: Optional[bool] = None,
+                       face_clusters: Optional[bool] = None):
     """Convert a Wavefront OBJ to v3d header. Optionally use metadata JSON containing:
         {
           "engine_scale": int,
-          "engine_brightness": [int, int, ...]
+          "engine_brightness": [int, int, ...],
+          "engine_lods": [{"distance": int, "cell_size": float}, ...],
+          "engine_packed_faces": bool,
+          "engine_face_clusters": bool
         }
     If engine_scale present, overrides modelscale.
     If engine_brightness list length matches face count, replaces random brightness.
+    Each engine_lods entry (or lods argument) adds a lower detail level, generated by
+    vertex clustering with the given cell size (in engine units) and used from the
+    given camera distance on.
+    If engine_packed_faces (or packed_faces argument) is true, every detail level also
+    gets its faces as separate arrays (packed_faces_3d), which the renderer reads instead.
+    If engine_face_clusters (or face_clusters argument) is true, faces are grouped by the
+    dominant axis of their normals, so the renderer can cull each group with one test.
     """
     with open(obj_path, 'rt') as waveobjfile:
         waveobjdata = waveobjfile.readlines()
@@ -97,6 +201,13 @@ def convert_wavefront(obj_path: str, out_path: str, modelname: str, modelscale:
                     pass
             if isinstance(metadata.get('engine_brightness'), list):
                 brightness_override = [int(max(0, min(7, int(v)))) for v in metadata['engine_brightness']]
+            if lods is None and isinstance(metadata.get('engine_lods'), list):
+                lods = [{'distance': int(l['distance']), 'cell_size': float(l['cell_size'])}
+                        for l in metadata['engine_lods']]
+            if packed_faces is None and 'engine_packed_faces' in metadata:
+                packed_faces = bool(metadata['engine_packed_faces'])
+            if face_clusters is None and 'engine_face_clusters' in metadata:
+                face_clusters = bool(metadata['engine_face_clusters'])
         except Exception as e:
             print(f"Warning: failed to load metadata '{metadata_path}': {e}")
 
@@ -176,6 +287,20 @@ def convert_wavefront(obj_path: str, out_path: str, modelname: str, modelscale:
     if not wavecolours:
         wavecolours.append('0 0 0')
 
+    use_override = len(brightness_override) == len(wavefacels)
+    facebrightness = [brightness_override[i] if use_override else randrange(8) for i in range(len(wavefacels))]
+    facematerials = [wavematerialindices[i] if i < len(wavematerialindices) else 0 for i in range(len(wavefacels))]
+
+    # Lower detail levels, from nearest to farthest:
+    lod_meshes = []
+    for lod in sorted(lods or [], key=lambda l: l['distance']):
+        mesh = decimate(wavevertices, wavefacels, facematerials, facebrightness, lod['cell_size'])
+        if not mesh[1]:
+            print(f"Warning: LOD with cell size {lod['cell_size']} has no faces; skipping it.")
+            continue
+        print(f"LOD at distance {lod['distance']}: {len(mesh[1])} faces, {len(mesh[0])} vertices")
+        lod_meshes.append((lod['distance'], mesh))
+
     # Write file now that data is validated
     with open(out_path, 'wt') as v3dfile:
         v3dfile.write(f"""\n    /*\n     * Based on Nikku4211's Wavefront to Varooom Converter (github.com/nikku4211/)\n     * Modified to support metadata (engine_scale / engine_brightness)\n     * Source OBJ: {os.path.basename(obj_path)}\n""")
@@ -192,13 +317,47 @@ def convert_wavefront(obj_path: str, out_path: str, modelname: str, modelscale:
         v3dfile.write("    };\n")
         for idx in range(len(wavecolours)):
             v3dfile.write(f"    constexpr inline int {modelname}_color_{idx} = {idx};\n")
-        v3dfile.write(f"\n    constexpr inline face_3d {modelname}_faces_full[] = {{\n")
-        use_override = len(brightness_override) == len(wavefacels)
-        for i, vnorm in enumerate(wavevertexnorms):
-            brightness_val = brightness_override[i] if use_override else randrange(8)
-            v3dfile.write('        face_3d(' + f'{modelname}_vertices, vertex_3d(' + f"{vnorm[0]},{vnorm[1]},{vnorm[2]})," + ','.join(wavefacels[i]) + ',' + f"{wavematerialindices[i] if i < len(wavematerialindices) else 0},{brightness_val}),\n")
-        v3dfile.write("    };\n")
-        v3dfile.write(f"    constexpr inline model_3d_item {modelname}_full({modelname}_vertices, {modelname}_faces_full, {modelname}_colors);\n")
+        def write_item(item_name, vertices_name, faces_name, normals, faces, materials, brightness, lower_detail):
+            order = list(range(len(normals)))
+            cluster_faces_counts = None
+            if face_clusters:
+                order, cluster_faces_counts = cluster_faces(normals)
+            v3dfile.write(f"    constexpr inline face_3d {faces_name}[] = {{\n")
+            for i in order:
+                vnorm = normals[i]
+                v3dfile.write('        face_3d(' + f'{vertices_name}, vertex_3d(' + f"{vnorm[0]},{vnorm[1]},{vnorm[2]})," + ','.join(faces[i]) + ',' + f"{materials[i]},{brightness[i]}),\n")
+            v3dfile.write("    };\n")
+            if packed_faces or face_clusters:
+                lower_detail_args = f"&{lower_detail[0]}, {lower_detail[1]}" if lower_detail else "nullptr, 0"
+                packed_faces_arg = "nullptr"
+                if packed_faces:
+                    v3dfile.write(f"    constexpr inline packed_faces_3d_array<{len(order)}> {item_name}_packed_faces_array({faces_name});\n")
+                    v3dfile.write(f"    constexpr inline packed_faces_3d {item_name}_packed_faces({item_name}_packed_faces_array);\n")
+                    packed_faces_arg = f"&{item_name}_packed_faces"
+                face_clusters_arg = ""
+                if face_clusters:
+                    v3dfile.write(f"    constexpr inline int {item_name}_cluster_faces_counts[] = {{{','.join(str(c) for c in cluster_faces_counts)}}};\n")
+                    v3dfile.write(f"    constexpr inline face_clusters_3d_array<{len(cluster_faces_counts)}> {item_name}_face_clusters({faces_name}, {item_name}_cluster_faces_counts);\n")
+                    face_clusters_arg = f", {item_name}_face_clusters.clusters()"
+                v3dfile.write(f"    constexpr inline model_3d_item {item_name}({vertices_name}, {faces_name}, nullptr, nullptr, {modelname}_colors, {lower_detail_args}, {packed_faces_arg}{face_clusters_arg});\n")
+            elif lower_detail:
+                v3dfile.write(f"    constexpr inline model_3d_item {item_name}({vertices_name}, {faces_name}, {modelname}_colors, {lower_detail[0]}, {lower_detail[1]});\n")
+            else:
+                v3dfile.write(f"    constexpr inline model_3d_item {item_name}({vertices_name}, {faces_name}, {modelname}_colors);\n")
+
+        # Farthest levels first, since each one references the next:
+        lower_detail = None
+        for lod_index in range(len(lod_meshes), 0, -1):
+            lod_name = f"{modelname}_lod_{lod_index}"
+            lod_vertices, lod_faces, lod_normals, lod_materials, lod_brightness = lod_meshes[lod_index - 1][1]
+            v3dfile.write(f"\n    constexpr inline vertex_3d {lod_name}_vertices[] = {{\n")
+            for v in lod_vertices:
+                v3dfile.write('             vertex_3d(' + ','.join(str(c) for c in v) + '),\n')
+            v3dfile.write("       };\n")
+            write_item(lod_name, f"{lod_name}_vertices", f"{lod_name}_faces", lod_normals, lod_faces, lod_materials, lod_brightness, lower_detail)
+            lower_detail = (lod_name, lod_meshes[lod_index - 1][0])
+        v3dfile.write("\n")
+        write_item(f"{modelname}_full", f"{modelname}_vertices", f"{modelname}_faces_full", wavevertexnorms, wavefacels, facematerials, facebrightness, lower_detail)
         v3dfile.write("    };\n")
         v3dfile.write(f"#endif // FR_MODEL_3D_ITEMS_{modelname.upper()}_H")
 
@@ -207,7 +366,7 @@ def main(argv):
     # Simple argument parser (manual to avoid adding dependency)
     import shlex
     if len(argv) <= 1 or any(a in argv for a in ('-h','--help')):
-        print('usage: wavefront2v3d.py input.obj output.hpp modelname modelscale [--recalcnorms] [--metadata meta.json]')
+        print('usage: wavefront2v3d.py input.obj output.hpp modelname modelscale [--recalcnorms] [--metadata meta.json] [--lod distance:cell_size ...] [--packed-faces] [--face-clusters]')
         return 0
     if len(argv) < 5:
         print('error: missing required arguments')
@@ -222,6 +381,8 @@ def main(argv):
         return 1
     recalc = False
     metadata_path = None
+    packed_faces = True if '--packed-faces' in argv else None
+    face_clusters = True if '--face-clusters' in argv else None
     for arg in argv[5:]:
         if arg in ('--recalcnorms','-rn'):
             recalc = True
@@ -234,7 +395,17 @@ def main(argv):
         idx = argv.index('--metadata')
         if idx+1 < len(argv):
             metadata_path = argv[idx+1]
-    convert_wavefront(input_obj, output_v3d, modelname, modelscale, recalcvertexnorms=recalc, metadata_path=metadata_path)
+    lods = None
+    for idx, arg in enumerate(argv):
+        try:
+            if arg.startswith('--lod='):
+                lods = (lods or []) + [parse_lod(arg.split('=', 1)[1])]
+            elif arg == '--lod' and idx+1 < len(argv):
+                lods = (lods or []) + [parse_lod(argv[idx+1])]
+        except Exception:
+            print('error: --lod expects distance:cell_size')
+            return 1
+    convert_wavefront(input_obj, output_v3d, modelname, modelscale, recalcvertexnorms=recalc, metadata_path=metadata_path, lods=lods, packed_faces=packed_faces, face_clusters=face_clusters)
     return 0
 
 if __name__=='__main__':